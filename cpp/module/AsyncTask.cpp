@@ -0,0 +1,104 @@
+#include <exception>
+#include <utility>
+
+#include "AsyncTask.h"
+#include "Scheduler.h"
+
+static const char* BUSY_MESSAGE = "Busy! Another operation is still running for this object.";
+static const char* FULL_MESSAGE = "Too many requests! Please wait for the previous operations to finish.";
+
+std::unordered_map<const std::atomic<bool>*, unsigned int> AsyncTask::pending{};
+
+/**Queues the given work on the strand of the owner and returns a Promise that is resolved with the value created by
+ * resolve or rejected with the message of the exception thrown by execute.
+ *
+ * @param info the call of the exported method; This() is kept alive until the task is finished
+ * @param busy flag of the owner that is set while the owner has queued or running tasks, also identifies its strand
+ * @param execute the work to do on a worker thread
+ * @param resolve creates the JS value the Promise is resolved with
+ * @return a Promise, rejected immediately if too many calls are pending
+ */
+Napi::Value AsyncTask::start(const Napi::CallbackInfo& info, std::atomic<bool>& busy,
+                             ExecuteFunction execute, ResolveFunction resolve) {
+    Napi::Env env = info.Env();
+    auto task = new AsyncTask(env, info.This().As<Napi::Object>(), busy, std::move(execute), std::move(resolve));
+    Napi::Promise promise = task->deferred.Promise();
+
+    if(!Scheduler::get().submit(&busy, [task] { task->run(); })) {
+        task->deferred.Reject(Napi::Error::New(env, FULL_MESSAGE).Value());
+        task->done.Release();
+        delete task;
+        return promise;
+    }
+    pending[&busy]++;
+    busy = true;
+    return promise;
+}
+
+/**Synchronous calls must not touch the package while a task is queued or running.
+ *
+ * @param env the environment to throw the error in
+ * @param busy flag of the owner
+ * @return true (after throwing an error) if a task is pending, false otherwise
+ */
+bool AsyncTask::isBusy(Napi::Env env, const std::atomic<bool>& busy) {
+    if(busy) {
+        Napi::Error::New(env, BUSY_MESSAGE).ThrowAsJavaScriptException();
+        return true;
+    }
+    return false;
+}
+
+AsyncTask::AsyncTask(Napi::Env env, Napi::Object owner, std::atomic<bool>& busy,
+                     ExecuteFunction execute, ResolveFunction resolve)
+        : deferred(Napi::Promise::Deferred::New(env)), owner(Napi::Persistent(owner)),
+          done(Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+                                             "QDDVisAsyncTask", 0, 1)),
+          busy(busy), execute(std::move(execute)), resolve(std::move(resolve)) {
+}
+
+/**Runs on a worker thread of the Scheduler.
+ *
+ */
+void AsyncTask::run() {
+    try {
+        execute();
+    } catch(std::exception& e) {
+        failed = true;
+        error = e.what();
+    } catch(...) {
+        failed = true;
+        error = "Unknown error!";
+    }
+
+    Napi::ThreadSafeFunction callback = done;   //the task may already be deleted when BlockingCall returns
+    callback.BlockingCall(this, [](Napi::Env env, Napi::Function, AsyncTask* task) {
+        task->finish(env);
+        delete task;
+    });
+    callback.Release();
+}
+
+/**Runs on the main thread once execute is done. Settles the Promise and lets the next call of the owner start.
+ *
+ * @param env the environment of the call
+ */
+void AsyncTask::finish(Napi::Env env) {
+    Napi::HandleScope scope(env);
+    auto it = pending.find(&busy);
+    if(--it->second == 0) {
+        pending.erase(it);
+        busy = false;
+    }
+
+    if(failed) {
+        deferred.Reject(Napi::Error::New(env, error).Value());
+    } else {
+        try {
+            deferred.Resolve(resolve(env));
+        } catch(std::exception& e) {    //the strand must be freed in any case
+            deferred.Reject(Napi::Error::New(env, e.what()).Value());
+        }
+    }
+    Scheduler::get().finished(&busy);
+}
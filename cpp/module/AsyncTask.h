@@ -0,0 +1,42 @@
+#ifndef QDD_VIS_ASYNCTASK_H
+#define QDD_VIS_ASYNCTASK_H
+
+#include <napi.h>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+/**Runs a piece of native work on the worker pool of the Scheduler and settles a Promise with its result on the main
+ * thread. Calls of the same owner are queued on the owner's strand and run one after another; while any of them is
+ * queued or running, the owner is marked as busy so no synchronous call touches the same dd::Package at once.
+ */
+class AsyncTask {
+public:
+    using ExecuteFunction = std::function<void()>;                  //runs on a worker thread, may throw
+    using ResolveFunction = std::function<Napi::Value(Napi::Env)>;  //runs on the main thread after execute succeeded
+
+    static Napi::Value start(const Napi::CallbackInfo& info, std::atomic<bool>& busy,
+                             ExecuteFunction execute, ResolveFunction resolve);
+    static bool isBusy(Napi::Env env, const std::atomic<bool>& busy);
+
+private:
+    AsyncTask(Napi::Env env, Napi::Object owner, std::atomic<bool>& busy,
+              ExecuteFunction execute, ResolveFunction resolve);
+
+    void run();
+    void finish(Napi::Env env);
+
+    static std::unordered_map<const std::atomic<bool>*, unsigned int> pending;  //calls per owner, main thread only
+
+    Napi::Promise::Deferred deferred;
+    Napi::ObjectReference owner;    //keeps the wrapped object alive while the task is pending
+    Napi::ThreadSafeFunction done;  //brings the task back to the main thread
+    std::atomic<bool>& busy;
+    ExecuteFunction execute;
+    ResolveFunction resolve;
+    bool failed = false;
+    std::string error{};
+};
+
+#endif //QDD_VIS_ASYNCTASK_H
@@ -0,0 +1,155 @@
+
+#include <algorithm>
+
+#include "CheckpointGrid.h"
+
+/**
+ *
+ * @param from a position
+ * @param to another position
+ * @return number of operations that have to be applied or undone to get from one position to the other
+ */
+unsigned int CheckpointGrid::distance(const Position& from, const Position& to) {
+    const unsigned int d1 = from.first > to.first ? from.first - to.first : to.first - from.first;
+    const unsigned int d2 = from.second > to.second ? from.second - to.second : to.second - from.second;
+    return d1 + d2;
+}
+
+/**Stores the given state as checkpoint for the given position (see CheckpointStore::store).
+ *
+ * @param dd the package the state belongs to
+ * @param position positions of both iterators at which the state was reached
+ * @param state the state of the verification at this position
+ * @param map1 the permutation of algo1 at this position
+ * @param map2 the permutation of algo2 at this position
+ * @param pinned whether the checkpoint must never be thinned out
+ */
+void CheckpointGrid::record(dd::Package& dd, const Position& position, const dd::Edge& state,
+                            const qc::permutationMap& map1, const qc::permutationMap& map2, bool pinned) {
+    Checkpoint cp;
+    cp.state = state;
+    cp.map1 = map1;
+    cp.map2 = map2;
+    cp.pinned = pinned;
+    store(dd, position, cp);
+}
+
+/**Records a checkpoint only if the nearest one is at least interval operations away (see CheckpointStore::isDue).
+ *
+ * @param dd the package the state belongs to
+ * @param position positions of both iterators at which the state was reached
+ * @param state the state of the verification at this position
+ * @param map1 the permutation of algo1 at this position
+ * @param map2 the permutation of algo2 at this position
+ */
+void CheckpointGrid::offer(dd::Package& dd, const Position& position, const dd::Edge& state,
+                           const qc::permutationMap& map1, const qc::permutationMap& map2) {
+    if(isDue(dd, position, state)) record(dd, position, state, map1, map2);
+}
+
+/**Removes all checkpoints whose position in one of the algorithms is at or after the given one, e.g. because the
+ * operations of this algorithm have been edited from there on.
+ *
+ * @param dd the package the states belong to
+ * @param algo1 whether position refers to algo1 or algo2
+ * @param position first position that is no longer valid
+ */
+void CheckpointGrid::dropFrom(dd::Package& dd, bool algo1, unsigned int position) {
+    auto it = checkpoints.begin();
+    while(it != checkpoints.end()) {
+        auto next = std::next(it);
+        if((algo1 ? it->first.first : it->first.second) >= position) release(dd, it);
+        it = next;
+    }
+}
+
+/**
+ *
+ * @param target the position we want to reach
+ * @param checkpointPos is set to the position of the returned checkpoint
+ * @param fixed1 if true, only checkpoints at the same position of algo1 as target are considered
+ * @param fixed2 if true, only checkpoints at the same position of algo2 as target are considered
+ * @return the checkpoint with the smallest distance to target or nullptr if there is none
+ */
+const CheckpointGrid::Checkpoint* CheckpointGrid::nearest(const Position& target, Position& checkpointPos,
+                                                          bool fixed1, bool fixed2) const {
+    const Checkpoint* best = nullptr;
+    unsigned int bestDistance = 0;
+    for(const auto& entry : checkpoints) {
+        if(fixed1 && entry.first.first != target.first) continue;
+        if(fixed2 && entry.first.second != target.second) continue;
+
+        const unsigned int d = distance(entry.first, target);
+        if(best == nullptr || d < bestDistance) {
+            best = &entry.second;
+            bestDistance = d;
+            checkpointPos = entry.first;
+        }
+    }
+    return best;
+}
+
+/**
+ *
+ * @param position a position
+ * @return the checkpoint at exactly this position or nullptr if there is none
+ */
+const CheckpointGrid::Checkpoint* CheckpointGrid::at(const Position& position) const {
+    auto it = checkpoints.find(position);
+    return it == checkpoints.end() ? nullptr : &it->second;
+}
+
+/**Builds a chain of checkpoints that could have been passed one after another on the way to limit, i.e. neither
+ * position decreases from one checkpoint of the chain to the next one. Starting at limit, the chain always continues
+ * with the checkpoint before it that is closest to it, so checkpoints left by stepping only one of the algorithms
+ * further than limit are skipped.
+ *
+ * @param limit the position the chain ends at (it is only part of the chain if there is a checkpoint at limit)
+ * @return the positions of the checkpoints of the chain, the one closest to the start first
+ */
+std::vector<CheckpointGrid::Position> CheckpointGrid::chainTo(const Position& limit) const {
+    std::vector<Position> candidates{};
+    for(const auto& entry : checkpoints) {
+        if(entry.first.first <= limit.first && entry.first.second <= limit.second) candidates.push_back(entry.first);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Position& a, const Position& b) {
+        const unsigned int opsA = a.first + a.second;
+        const unsigned int opsB = b.first + b.second;
+        return opsA != opsB ? opsA > opsB : a.first > b.first;
+    });
+
+    std::vector<Position> chain{};
+    Position last = limit;
+    for(const Position& p : candidates) {
+        if(p.first <= last.first && p.second <= last.second) {
+            chain.push_back(p);
+            last = p;
+        }
+    }
+    std::reverse(chain.begin(), chain.end());
+    return chain;
+}
+
+/**Removes the unpinned checkpoint that is closest to any other checkpoint, so the remaining ones stay as evenly
+ * spread as possible.
+ *
+ * @param dd the package the states belong to
+ * @param keep position of the checkpoint that was just recorded, it is never removed
+ */
+void CheckpointGrid::thinOut(dd::Package& dd, const Position& keep) {
+    auto victim = checkpoints.end();
+    unsigned int smallestGap = 0;
+    for(auto it = checkpoints.begin(); it != checkpoints.end(); ++it) {
+        if(it->second.pinned || it->first == keep) continue;
+
+        for(auto other = checkpoints.begin(); other != checkpoints.end(); ++other) {
+            if(other == it) continue;
+            const unsigned int gap = distance(it->first, other->first);
+            if(victim == checkpoints.end() || gap < smallestGap) {
+                victim = it;
+                smallestGap = gap;
+            }
+        }
+    }
+    if(victim != checkpoints.end()) release(dd, victim);
+}
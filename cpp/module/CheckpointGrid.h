@@ -0,0 +1,48 @@
+#ifndef QDD_VIS_CHECKPOINTGRID_H
+#define QDD_VIS_CHECKPOINTGRID_H
+
+#include <utility>
+#include <vector>
+
+#include "operations/Operation.hpp"
+#include "DDpackage.h"
+
+#include "CheckpointStore.h"
+
+struct VerificationCheckpoint {
+    dd::Edge state{};
+    qc::permutationMap map1{};  //permutation of algo1 at this position (SWAPs change it)
+    qc::permutationMap map2{};  //permutation of algo2 at this position
+    bool pinned = false;        //pinned checkpoints (the start) are never thinned out
+};
+
+/**Two-dimensional counterpart of Checkpoints for QDDVer, whose state depends on the positions in both algorithms.
+ * States are stored for a sparse set of (position1, position2) pairs, so moving either iterator restores the nearest
+ * one and only applies or undoes the operations between it and the target. The distance between two positions is the
+ * number of operations needed to get from one to the other (see CheckpointStore for ref-counting and the interval).
+ */
+class CheckpointGrid : public CheckpointStore<CheckpointGrid, std::pair<unsigned int, unsigned int>, VerificationCheckpoint> {
+public:
+    using Position = std::pair<unsigned int, unsigned int>;     //position1, position2
+    using Checkpoint = VerificationCheckpoint;
+
+    static unsigned int distance(const Position& from, const Position& to);
+
+    void record(dd::Package& dd, const Position& position, const dd::Edge& state, const qc::permutationMap& map1,
+                const qc::permutationMap& map2, bool pinned = false);
+    void offer(dd::Package& dd, const Position& position, const dd::Edge& state, const qc::permutationMap& map1,
+               const qc::permutationMap& map2);
+    void dropFrom(dd::Package& dd, bool algo1, unsigned int position);
+
+    const Checkpoint* nearest(const Position& target, Position& checkpointPos, bool fixed1 = false,
+                              bool fixed2 = false) const;
+    const Checkpoint* at(const Position& position) const;
+    std::vector<Position> chainTo(const Position& limit) const;
+
+private:
+    friend class CheckpointStore<CheckpointGrid, Position, Checkpoint>;
+
+    void thinOut(dd::Package& dd, const Position& keep);
+};
+
+#endif //QDD_VIS_CHECKPOINTGRID_H
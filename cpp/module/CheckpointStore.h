@@ -0,0 +1,114 @@
+#ifndef QDD_VIS_CHECKPOINTSTORE_H
+#define QDD_VIS_CHECKPOINTSTORE_H
+
+#include <algorithm>
+#include <map>
+
+#include "DDpackage.h"
+
+/**Common part of Checkpoints and CheckpointGrid: a sparse map from positions to ref-counted states, so the garbage
+ * collection of the package leaves them untouched, together with the interval between two offered checkpoints that is
+ * adapted to the size of the DD.
+ * Derived has to provide distance(Position, Position), nearest(Position, Position&) (the checkpoint offer measures
+ * the interval from) and thinOut(dd::Package&, Position keep) (removes one unpinned checkpoint other than keep).
+ * Checkpoint needs the members state and pinned.
+ */
+template<class Derived, class Position, class Checkpoint>
+class CheckpointStore {
+public:
+    static constexpr unsigned int MIN_INTERVAL = 8;         //minimal distance between two checkpoints
+    static constexpr unsigned int MAX_INTERVAL = 256;       //maximal distance between two checkpoints
+    static constexpr unsigned int NODES_PER_INTERVAL = 512; //the interval grows by MIN_INTERVAL for every this many nodes
+    static constexpr std::size_t MAX_CHECKPOINTS = 64;      //more checkpoints than this are thinned out
+
+    /**Removes all checkpoints that are not pinned. Positions between the pinned ones are reached by replaying the
+     * operations again afterwards.
+     *
+     * @param dd the package the states belong to
+     */
+    void dropUnpinned(dd::Package& dd) {
+        auto it = checkpoints.begin();
+        while(it != checkpoints.end()) {
+            auto next = std::next(it);
+            if(!it->second.pinned) release(dd, it);
+            it = next;
+        }
+    }
+
+    /**Removes all checkpoints.
+     *
+     * @param dd the package the states belong to
+     */
+    void clear(dd::Package& dd) {
+        for(auto& entry : checkpoints) dd.decRef(entry.second.state);
+        checkpoints.clear();
+        interval = MIN_INTERVAL;
+    }
+
+    std::size_t size() const { return checkpoints.size(); }
+    unsigned int getInterval() const { return interval; }
+
+protected:
+    /**Stores cp for the given position. An already existing checkpoint at this position is replaced (it stays pinned
+     * if it was). The state is ref-counted until the checkpoint is dropped again.
+     *
+     * @param dd the package the state belongs to
+     * @param position the position at which the state was reached
+     * @param cp the checkpoint, its state isn't ref-counted yet
+     */
+    void store(dd::Package& dd, const Position& position, Checkpoint cp) {
+        auto it = checkpoints.find(position);
+        if(it != checkpoints.end()) {
+            cp.pinned = cp.pinned || it->second.pinned;
+            release(dd, it);
+        }
+
+        dd.incRef(cp.state);
+        checkpoints.emplace(position, cp);
+
+        if(checkpoints.size() > MAX_CHECKPOINTS) static_cast<Derived*>(this)->thinOut(dd, position);
+    }
+
+    /**Decides whether an offered state should be recorded: only if the nearest checkpoint is at least interval
+     * operations away. The interval is adapted to the size of the DD beforehand (which is only computed if the
+     * previous interval has passed): bigger DDs are more expensive to retain, so they are stored less often.
+     *
+     * @param dd the package the state belongs to
+     * @param position the position at which the state was reached
+     * @param state the offered state
+     * @return true if the state should be recorded
+     */
+    bool isDue(dd::Package& dd, const Position& position, const dd::Edge& state) {
+        if(isNear(position)) return false;
+
+        const unsigned int nodes = dd.size(state);
+        interval = std::min(MAX_INTERVAL, MIN_INTERVAL * (1 + nodes / NODES_PER_INTERVAL));
+        return !isNear(position);
+    }
+
+    void release(dd::Package& dd, typename std::map<Position, Checkpoint>::iterator it) {
+        dd.decRef(it->second.state);
+        checkpoints.erase(it);
+    }
+
+    std::map<Position, Checkpoint> checkpoints{};
+    unsigned int interval = MIN_INTERVAL;   //adapted to the size of the DD whenever a checkpoint is offered
+
+private:
+    bool isNear(const Position& position) const {
+        const Derived& self = static_cast<const Derived&>(*this);
+        Position prevPos{};
+        return self.nearest(position, prevPos) != nullptr && Derived::distance(prevPos, position) < interval;
+    }
+};
+
+template<class Derived, class Position, class Checkpoint>
+constexpr unsigned int CheckpointStore<Derived, Position, Checkpoint>::MIN_INTERVAL;
+template<class Derived, class Position, class Checkpoint>
+constexpr unsigned int CheckpointStore<Derived, Position, Checkpoint>::MAX_INTERVAL;
+template<class Derived, class Position, class Checkpoint>
+constexpr unsigned int CheckpointStore<Derived, Position, Checkpoint>::NODES_PER_INTERVAL;
+template<class Derived, class Position, class Checkpoint>
+constexpr std::size_t CheckpointStore<Derived, Position, Checkpoint>::MAX_CHECKPOINTS;
+
+#endif //QDD_VIS_CHECKPOINTSTORE_H
@@ -0,0 +1,86 @@
+
+#include <algorithm>
+
+#include "Checkpoints.h"
+
+/**Stores the given state as checkpoint for the given position (see CheckpointStore::store).
+ *
+ * @param dd the package the state belongs to
+ * @param position number of operations that have been applied to reach the state
+ * @param state the simulation state after position operations
+ * @param measurements the classical bits at this position
+ * @param pinned whether the checkpoint must never be thinned out (e.g. because it can't be recomputed)
+ */
+void Checkpoints::record(dd::Package& dd, unsigned int position, const dd::Edge& state,
+                         const std::bitset<qc::MAX_QUBITS>& measurements, bool pinned) {
+    Checkpoint cp;
+    cp.state = state;
+    cp.measurements = measurements;
+    cp.pinned = pinned;
+    store(dd, position, cp);
+}
+
+/**Records a checkpoint only if at least interval operations have passed since the previous one (see
+ * CheckpointStore::isDue).
+ *
+ * @param dd the package the state belongs to
+ * @param position number of operations that have been applied to reach the state
+ * @param state the simulation state after position operations
+ * @param measurements the classical bits at this position
+ */
+void Checkpoints::offer(dd::Package& dd, unsigned int position, const dd::Edge& state,
+                        const std::bitset<qc::MAX_QUBITS>& measurements) {
+    if(isDue(dd, position, state)) record(dd, position, state, measurements);
+}
+
+/**Removes all checkpoints at or after the given position, e.g. because a measurement changed the state at this
+ * position or the operations after it have been edited.
+ *
+ * @param dd the package the states belong to
+ * @param position first position that is no longer valid
+ */
+void Checkpoints::dropFrom(dd::Package& dd, unsigned int position) {
+    auto it = checkpoints.lower_bound(position);
+    while(it != checkpoints.end()) {
+        auto next = std::next(it);
+        release(dd, it);
+        it = next;
+    }
+}
+
+/**
+ *
+ * @param position the position we want to reach
+ * @param checkpointPos is set to the position of the returned checkpoint
+ * @return the checkpoint with the biggest position that is not after the given one or nullptr if there is none
+ */
+const Checkpoints::Checkpoint* Checkpoints::nearest(unsigned int position, unsigned int& checkpointPos) const {
+    auto it = checkpoints.upper_bound(position);
+    if(it == checkpoints.begin()) return nullptr;
+    --it;
+    checkpointPos = it->first;
+    return &it->second;
+}
+
+/**Removes the unpinned checkpoint whose removal creates the smallest gap between its two neighbours, so the
+ * remaining checkpoints stay as evenly spread as possible.
+ *
+ * @param dd the package the states belong to
+ * @param keep position of the checkpoint that was just recorded, it is never removed
+ */
+void Checkpoints::thinOut(dd::Package& dd, unsigned int keep) {
+    auto victim = checkpoints.end();
+    unsigned int smallestGap = 0;
+    for(auto it = checkpoints.begin(); it != checkpoints.end(); ++it) {
+        if(it->second.pinned || it->first == keep || it == checkpoints.begin()) continue;
+        auto next = std::next(it);
+        if(next == checkpoints.end()) continue;     //the last checkpoint is the most recent one, keep it
+
+        const unsigned int gap = next->first - std::prev(it)->first;
+        if(victim == checkpoints.end() || gap < smallestGap) {
+            victim = it;
+            smallestGap = gap;
+        }
+    }
+    if(victim != checkpoints.end()) release(dd, victim);
+}
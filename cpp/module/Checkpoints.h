@@ -0,0 +1,42 @@
+#ifndef QDD_VIS_CHECKPOINTS_H
+#define QDD_VIS_CHECKPOINTS_H
+
+#include <bitset>
+
+#include "operations/Operation.hpp"
+#include "DDpackage.h"
+
+#include "CheckpointStore.h"
+
+struct SimulationCheckpoint {
+    dd::Edge state{};
+    std::bitset<qc::MAX_QUBITS> measurements{};
+    bool pinned = false;    //pinned checkpoints (start, after irreversible operations) are never thinned out
+};
+
+/**Sparse store of simulation states that allows to jump to an arbitrary position by restoring the nearest
+ * checkpoint and replaying at most a few operations instead of undoing or redoing every single one of them.
+ * The position is the number of applied operations (see CheckpointStore for ref-counting and the interval).
+ */
+class Checkpoints : public CheckpointStore<Checkpoints, unsigned int, SimulationCheckpoint> {
+public:
+    using Checkpoint = SimulationCheckpoint;
+
+    static unsigned int distance(unsigned int from, unsigned int to) { return from > to ? from - to : to - from; }
+
+    void record(dd::Package& dd, unsigned int position, const dd::Edge& state,
+                const std::bitset<qc::MAX_QUBITS>& measurements, bool pinned = false);
+    void offer(dd::Package& dd, unsigned int position, const dd::Edge& state,
+               const std::bitset<qc::MAX_QUBITS>& measurements);
+    void dropFrom(dd::Package& dd, unsigned int position);
+
+    const Checkpoint* nearest(unsigned int position, unsigned int& checkpointPos) const;
+    bool has(unsigned int position) const { return checkpoints.count(position) > 0; }
+
+private:
+    friend class CheckpointStore<Checkpoints, unsigned int, SimulationCheckpoint>;
+
+    void thinOut(dd::Package& dd, unsigned int keep);
+};
+
+#endif //QDD_VIS_CHECKPOINTS_H
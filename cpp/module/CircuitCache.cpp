@@ -0,0 +1,117 @@
+#include "CircuitCache.h"
+
+#include <sstream>
+
+std::mutex CircuitCache::mutex{};
+std::unordered_map<CircuitCache::Key, CircuitCache::Entry, CircuitCache::KeyHash> CircuitCache::entries{};
+std::list<const CircuitCache::Key*> CircuitCache::usage{};
+unsigned long long CircuitCache::hits = 0;
+unsigned long long CircuitCache::misses = 0;
+
+/**
+ *
+ * @param algo the algorithm as text
+ * @param format format of the algorithm
+ * @return the parsed algorithm, shared with every other session that loaded the same text
+ * @throws what QuantumComputation::import throws if the algorithm is invalid (invalid algorithms aren't cached)
+ */
+CircuitCache::Circuit CircuitCache::get(const std::string& algo, qc::Format format) {
+    return lookup(algo, format, false);
+}
+
+/**Parses the given algorithm (if it isn't cached yet) and keeps it for the whole lifetime of the process.
+ *
+ * @param algo the algorithm as text
+ * @param format format of the algorithm
+ * @return the parsed algorithm
+ * @throws what QuantumComputation::import throws if the algorithm is invalid
+ */
+CircuitCache::Circuit CircuitCache::preload(const std::string& algo, qc::Format format) {
+    return lookup(algo, format, true);
+}
+
+/**
+ *
+ * @return an algorithm without qubits and operations, used before anything was loaded
+ */
+CircuitCache::Circuit CircuitCache::empty() {
+    static const Circuit circuit = std::make_shared<qc::QuantumComputation>();
+    return circuit;
+}
+
+/**Returns the cached algorithm or parses and caches it.
+ *
+ * @param algo the algorithm as text
+ * @param format format of the algorithm
+ * @param preloaded whether the entry must never be dropped
+ * @return the parsed algorithm
+ * @throws what QuantumComputation::import throws if the algorithm is invalid
+ */
+CircuitCache::Circuit CircuitCache::lookup(const std::string& algo, qc::Format format, bool preloaded) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(Key{algo, format});
+        if(it != entries.end()) {
+            hits++;
+            Entry& e = it->second;
+            if(preloaded && !e.preloaded) {
+                usage.erase(e.use);
+                e.preloaded = true;
+            } else if(!e.preloaded) {
+                usage.splice(usage.begin(), usage, e.use);
+            }
+            return e.circuit;
+        }
+        misses++;
+    }
+
+    //parse without holding the lock, so other sessions aren't blocked meanwhile
+    auto parsed = std::make_shared<qc::QuantumComputation>();
+    std::stringstream ss{algo};
+    parsed->import(ss, format);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto inserted = entries.emplace(Key{algo, format}, Entry{});
+    Entry& e = inserted.first->second;
+    if(!inserted.second) return e.circuit;  //another session parsed the same algorithm meanwhile
+
+    e.circuit = parsed;
+    e.preloaded = preloaded;
+    if(!preloaded) {
+        usage.push_front(&inserted.first->first);
+        e.use = usage.begin();
+        if(usage.size() > MAX_ENTRIES) {
+            auto oldest = entries.find(*usage.back());
+            usage.pop_back();
+            entries.erase(oldest);      //sessions that still use the algorithm keep their own reference
+        }
+    }
+    return e.circuit;
+}
+
+/**
+ *
+ * @return how many loads found their algorithm in the cache
+ */
+unsigned long long CircuitCache::getHits() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+/**
+ *
+ * @return how many loads had to parse their algorithm
+ */
+unsigned long long CircuitCache::getMisses() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+/**
+ *
+ * @return number of cached algorithms (including the preloaded ones)
+ */
+std::size_t CircuitCache::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
@@ -0,0 +1,60 @@
+#ifndef QDD_VIS_CIRCUITCACHE_H
+#define QDD_VIS_CIRCUITCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "QuantumComputation.hpp"
+
+/**Process-wide cache of parsed algorithms, keyed by their text and format, so loading an algorithm that was already
+ * parsed (e.g. after the editor only changed opNum, or a popular example) is a hash lookup instead of a parse.
+ * Cached computations are immutable and shared by all sessions that loaded the same text; a session only keeps its own
+ * iterator into them. The least recently used entries are dropped once there are more than MAX_ENTRIES, except the
+ * preloaded ones (the examples), which stay for the whole lifetime of the process.
+ * All functions are thread-safe, since loads run on worker threads.
+ */
+class CircuitCache {
+public:
+    using Circuit = std::shared_ptr<const qc::QuantumComputation>;
+
+    static constexpr std::size_t MAX_ENTRIES = 64;  //not counting the preloaded ones
+
+    static Circuit get(const std::string& algo, qc::Format format);
+    static Circuit preload(const std::string& algo, qc::Format format);
+    static Circuit empty();
+
+    static unsigned long long getHits();
+    static unsigned long long getMisses();
+    static std::size_t size();
+
+private:
+    struct Key {
+        std::string algo;
+        qc::Format format;
+        bool operator==(const Key& other) const { return format == other.format && algo == other.algo; }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<std::string>{}(key.algo) * 31 + static_cast<std::size_t>(key.format);
+        }
+    };
+    struct Entry {
+        Circuit circuit{};
+        bool preloaded = false;
+        std::list<const Key*>::iterator use{};  //position in the usage order (only if not preloaded)
+    };
+
+    static Circuit lookup(const std::string& algo, qc::Format format, bool preloaded);
+
+    static std::mutex mutex;
+    static std::unordered_map<Key, Entry, KeyHash> entries;
+    static std::list<const Key*> usage;     //keys of the entries that may be dropped, most recently used first
+    static unsigned long long hits;
+    static unsigned long long misses;
+};
+
+#endif //QDD_VIS_CIRCUITCACHE_H
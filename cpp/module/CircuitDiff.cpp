@@ -0,0 +1,54 @@
+#include "CircuitDiff.h"
+#include "operations/CompoundOperation.hpp"
+
+/**
+ *
+ * @param before the algorithm that was loaded so far
+ * @param after the algorithm that is loaded now
+ * @return number of leading operations both algorithms have in common (0 if their qubits or initial layouts differ)
+ */
+unsigned int CircuitDiff::firstDifference(const qc::QuantumComputation& before, const qc::QuantumComputation& after) {
+    if(before.getNqubits() != after.getNqubits() || before.initialLayout != after.initialLayout) return 0;
+
+    unsigned int index = 0;
+    auto a = before.begin();
+    auto b = after.begin();
+    while(a != before.end() && b != after.end() && equals(**a, **b)) {
+        ++a;
+        ++b;
+        ++index;
+    }
+    return index;
+}
+
+/**
+ *
+ * @param a an operation
+ * @param b another operation
+ * @return true if applying a has the same effect as applying b
+ */
+bool CircuitDiff::equals(const qc::Operation& a, const qc::Operation& b) {
+    if(&a == &b) return true;   //both algorithms were loaded from the same (cached) text
+    if(a.getType() != b.getType() || a.getNqubits() != b.getNqubits()) return false;
+    if(a.isClassicControlledOperation() || b.isClassicControlledOperation()) return false;
+    if(a.getTargets() != b.getTargets() || a.getParameter() != b.getParameter()) return false;
+
+    const auto& controlsA = a.getControls();
+    const auto& controlsB = b.getControls();
+    if(controlsA.size() != controlsB.size()) return false;
+    for(std::size_t i = 0; i < controlsA.size(); i++) {
+        if(controlsA[i].qubit != controlsB[i].qubit || controlsA[i].type != controlsB[i].type) return false;
+    }
+
+    if(a.getType() == qc::Compound) {
+        const auto* compoundA = dynamic_cast<const qc::CompoundOperation*>(&a);
+        const auto* compoundB = dynamic_cast<const qc::CompoundOperation*>(&b);
+        if(compoundA == nullptr || compoundB == nullptr || compoundA->size() != compoundB->size()) return false;
+        auto opB = compoundB->begin();
+        for(const auto& opA : *compoundA) {
+            if(!equals(*opA, **opB)) return false;
+            ++opB;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,18 @@
+#ifndef QDD_VIS_CIRCUITDIFF_H
+#define QDD_VIS_CIRCUITDIFF_H
+
+#include "operations/Operation.hpp"
+#include "QuantumComputation.hpp"
+
+/**Compares two algorithms operation by operation, so a load after an edit only has to re-simulate the operations from
+ * the first edited one on. Operations are compared by their type, qubits and parameters; compound operations
+ * (e.g. custom gates) are compared recursively. Classic-controlled operations are only considered equal if they are the
+ * same object, since their inner operation can't be compared.
+ */
+class CircuitDiff {
+public:
+    static unsigned int firstDifference(const qc::QuantumComputation& before, const qc::QuantumComputation& after);
+    static bool equals(const qc::Operation& a, const qc::Operation& b);
+};
+
+#endif //QDD_VIS_CIRCUITDIFF_H
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Counterexample.h"
+#include "Equivalence.h"
+
+/**Searches the entry of result that shows best that it isn't the identity (see the class description).
+ * Every node of the DD is visited once at most, the path to the entry only takes one step per qubit.
+ *
+ * @param result the DD after the operations of both algorithms have been applied
+ * @param identity the DD the verification started with
+ * @param counterexample is filled with everything but the members describing the diverging operation
+ * @return false if result is the identity up to a global phase (counterexample stays unchanged), true otherwise
+ */
+bool Counterexample::find(const dd::Edge& result, const dd::Edge& identity, Result& counterexample) {
+    if(Equivalence::compare(result, identity) != Equivalence::Verdict::NotEquivalent) return false;
+    if(result.p == nullptr || result.p == dd::Package::terminalNode) return false;
+
+    const unsigned short nqubits = result.p->v + 1;
+    std::string output(nqubits, '0');
+    std::string input(nqubits, '0');
+
+    std::unordered_map<dd::NodePtr, Bound> memo{};
+    if(bound(result.p, memo).off > 0) {
+        //follow the edges with the biggest bound, until the path went off the diagonal once
+        bool offDiagonal = false;
+        dd::NodePtr p = result.p;
+        while(p != dd::Package::terminalNode) {
+            int best = -1;
+            fp bestValue = -1;
+            for(int i = 0; i < dd::NEDGE; i++) {
+                const dd::Edge& e = p->e[i];
+                if(CN::equalsZero(e.w)) continue;
+                const Bound b = bound(e.p, memo);
+                const bool leavesDiagonal = (i == 1 || i == 2);
+                const fp value = CN::mag(e.w) * (offDiagonal || leavesDiagonal ? b.any : b.off);
+                if(value > bestValue) {
+                    best = i;
+                    bestValue = value;
+                }
+            }
+            if(best < 0) break;     //can't happen for a valid DD
+            if(best == 1 || best == 2) offDiagonal = true;
+            output[nqubits - 1 - p->v] = (best & 2) ? '1' : '0';
+            input[nqubits - 1 - p->v] = (best & 1) ? '1' : '0';
+            p = p->e[best].p;
+        }
+
+    } else {
+        //result is diagonal, so it differs from the identity in a diagonal entry
+        dd::NodePtr p = result.p;
+        dd::NodePtr q = identity.p;
+        while(p != dd::Package::terminalNode) {
+            int next = 0;   //stay on the first diagonal entry if neither edge differs (only the root weight does)
+            for(int i : {0, 3}) {
+                const dd::Edge& e = p->e[i];
+                const bool differs = q == nullptr || q == dd::Package::terminalNode || q->e[i].p != e.p ||
+                                     !CN::equals(q->e[i].w, e.w);
+                if(differs && !CN::equalsZero(e.w)) {
+                    next = i;
+                    break;
+                }
+            }
+            output[nqubits - 1 - p->v] = next == 3 ? '1' : '0';
+            input[nqubits - 1 - p->v] = next == 3 ? '1' : '0';
+            q = (q == nullptr || q == dd::Package::terminalNode) ? nullptr : q->e[next].p;
+            p = p->e[next].p;
+        }
+    }
+
+    const std::complex<fp> actual = entry(result, output, input);
+    const std::complex<fp> expected = entry(identity, output, input);
+    counterexample.found = true;
+    counterexample.input = input;
+    counterexample.output = output;
+    counterexample.re = actual.real();
+    counterexample.im = actual.imag();
+    counterexample.expectedRe = expected.real();
+    counterexample.expectedIm = expected.imag();
+    counterexample.deviation = std::abs(actual - expected);
+    return true;
+}
+
+/**
+ *
+ * @param env the environment the object is created in
+ * @param counterexample the result of find
+ * @return object with members found, input, output, amplitude {re, im}, expected {re, im}, deviation and divergence
+ *          {position1, position2, algo1, operation} (null if the diverging operation couldn't be found)
+ */
+Napi::Object Counterexample::toObject(Napi::Env env, const Result& counterexample) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("found", Napi::Boolean::New(env, counterexample.found));
+    if(!counterexample.found) return obj;
+
+    obj.Set("input", Napi::String::New(env, counterexample.input));
+    obj.Set("output", Napi::String::New(env, counterexample.output));
+    Napi::Object amplitude = Napi::Object::New(env);
+    amplitude.Set("re", Napi::Number::New(env, counterexample.re));
+    amplitude.Set("im", Napi::Number::New(env, counterexample.im));
+    obj.Set("amplitude", amplitude);
+    Napi::Object expected = Napi::Object::New(env);
+    expected.Set("re", Napi::Number::New(env, counterexample.expectedRe));
+    expected.Set("im", Napi::Number::New(env, counterexample.expectedIm));
+    obj.Set("expected", expected);
+    obj.Set("deviation", Napi::Number::New(env, counterexample.deviation));
+
+    if(counterexample.operation < 0) {
+        obj.Set("divergence", env.Null());
+    } else {
+        Napi::Object divergence = Napi::Object::New(env);
+        divergence.Set("position1", Napi::Number::New(env, counterexample.position1));
+        divergence.Set("position2", Napi::Number::New(env, counterexample.position2));
+        divergence.Set("algo1", Napi::Boolean::New(env, counterexample.algo1));
+        divergence.Set("operation", Napi::Number::New(env, counterexample.operation));
+        obj.Set("divergence", divergence);
+    }
+    return obj;
+}
+
+/**Computes the biggest magnitudes of all entries and of the off-diagonal entries of the matrix below a node. Since
+ * the magnitude of an entry is the product of the magnitudes of the weights on its path, both are maxima over the
+ * edges of the node.
+ *
+ * @param p a node of the matrix
+ * @param memo bounds of the nodes that were already computed
+ * @return the bounds of p
+ */
+Counterexample::Bound Counterexample::bound(dd::NodePtr p, std::unordered_map<dd::NodePtr, Bound>& memo) {
+    if(p == dd::Package::terminalNode) return Bound{1, -1};
+    auto it = memo.find(p);
+    if(it != memo.end()) return it->second;
+
+    Bound result{};
+    for(int i = 0; i < dd::NEDGE; i++) {
+        const dd::Edge& e = p->e[i];
+        if(CN::equalsZero(e.w)) continue;
+        const Bound b = bound(e.p, memo);
+        const fp mag = CN::mag(e.w);
+        result.any = std::max(result.any, mag * b.any);
+        if(i == 1 || i == 2)    result.off = std::max(result.off, mag * b.any);
+        else if(b.off >= 0)     result.off = std::max(result.off, mag * b.off);
+    }
+    memo.emplace(p, result);
+    return result;
+}
+
+/**
+ *
+ * @param e a matrix
+ * @param output the row as basis state, the most significant qubit first
+ * @param input the column as basis state, the most significant qubit first
+ * @return the entry of the matrix at the given row and column
+ */
+std::complex<fp> Counterexample::entry(const dd::Edge& e, const std::string& output, const std::string& input) {
+    const std::size_t nqubits = output.size();
+    std::complex<fp> value{CN::val(e.w.r), CN::val(e.w.i)};
+    dd::NodePtr p = e.p;
+    while(p != nullptr && p != dd::Package::terminalNode) {
+        const std::size_t idx = nqubits - 1 - p->v;
+        const int i = (output[idx] == '1' ? 2 : 0) + (input[idx] == '1' ? 1 : 0);
+        const dd::Edge& next = p->e[i];
+        if(CN::equalsZero(next.w)) return {0, 0};
+        value *= std::complex<fp>{CN::val(next.w.r), CN::val(next.w.i)};
+        p = next.p;
+    }
+    return value;
+}
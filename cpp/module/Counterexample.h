@@ -0,0 +1,46 @@
+#ifndef QDD_VIS_COUNTEREXAMPLE_H
+#define QDD_VIS_COUNTEREXAMPLE_H
+
+#include <napi.h>
+#include <complex>
+#include <string>
+#include <unordered_map>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Explains why the result of a verification is not the identity: a basis input |x> and output <y| whose entry of the
+ * resulting matrix differs from the one of the identity. Off-diagonal entries are preferred, since they show that an
+ * input is mapped to the wrong output; the one with the biggest magnitude is found by following the edges that lead
+ * to the biggest product of weight magnitudes, which are computed once per node. If the result is diagonal, the
+ * diagonal entry is taken that is reached by following the first edge in which result and identity differ.
+ */
+class Counterexample {
+public:
+    struct Result {
+        bool found = false;         //false if the result is the identity (up to a global phase)
+        std::string input;          //basis state |x>, the most significant qubit first
+        std::string output;         //basis state <y|, the most significant qubit first
+        fp re = 0, im = 0;          //<y|result|x>
+        fp expectedRe = 0, expectedIm = 0;  //<y|identity|x>
+        fp deviation = 0;           //distance between both entries
+        long long position1 = -1;   //positions right after the operation that made the result diverge from the identity
+        long long position2 = -1;   //(-1 if it couldn't be found)
+        bool algo1 = false;         //whether that operation belongs to algo1 or algo2
+        long long operation = -1;   //index of that operation in its algorithm
+    };
+
+    static bool find(const dd::Edge& result, const dd::Edge& identity, Result& counterexample);
+    static Napi::Object toObject(Napi::Env env, const Result& counterexample);
+
+private:
+    struct Bound {
+        fp any = 0;     //biggest magnitude of all entries below the node
+        fp off = -1;    //biggest magnitude of the off-diagonal entries below the node (-1 if there are none)
+    };
+
+    static Bound bound(dd::NodePtr p, std::unordered_map<dd::NodePtr, Bound>& memo);
+    static std::complex<fp> entry(const dd::Edge& e, const std::string& output, const std::string& input);
+};
+
+#endif //QDD_VIS_COUNTEREXAMPLE_H
@@ -0,0 +1,126 @@
+
+#include "DDDiff.h"
+
+/**Compares the given DD with the last exported one and remembers it as the new last export.
+ *
+ * @param dd the package root belongs to
+ * @param root the DD to export
+ * @param isVector whether root is a vector DD (only e[0] and e[2] of its nodes are exported) or a matrix DD
+ * @return the nodes that have to be added to and removed from the last export to get root
+ */
+DDDiff::Result DDDiff::diff(dd::Package& dd, const dd::Edge& root, bool isVector) {
+    Result result;
+    result.base = version;
+    if(exported.p != nullptr && exported.p == root.p && CN::equals(exported.w, root.w)) {
+        result.version = version;
+        return result;
+    }
+
+    reached.clear();
+    result.changed = true;
+    result.root = CN::equalsZero(root.w) || dd::Package::isTerminal(root) ? 0 : collect(root.p, isVector ? 2 : 4, result);
+    result.rootRe = CN::val(root.w.r);
+    result.rootIm = CN::val(root.w.i);
+
+    for(auto it = ids.begin(); it != ids.end(); ) {
+        if(reached.count(it->first) == 0) {
+            result.removed.push_back(it->second);
+            it = ids.erase(it);
+        } else ++it;
+    }
+    reached.clear();
+
+    dd::Edge next = root;
+    dd.incRef(next);
+    if(exported.p != nullptr) dd.decRef(exported);
+    exported = next;
+    result.version = ++version;
+    return result;
+}
+
+/**Forgets the last export, so the next diff starts from the empty graph (base 0).
+ *
+ * @param dd the package the last export belongs to
+ */
+void DDDiff::clear(dd::Package& dd) {
+    if(exported.p != nullptr) dd.decRef(exported);
+    exported = dd::Edge{};
+    ids.clear();
+    version = 0;
+}
+
+/**Marks the given node and all nodes below it as reached and adds those without an id to the result.
+ *
+ * @param p a non-terminal node
+ * @param arity number of edges to export per node
+ * @param result the added nodes are appended to it
+ * @return id of p
+ */
+std::uint32_t DDDiff::collect(dd::NodePtr p, unsigned int arity, Result& result) {
+    auto known = ids.find(p);
+    if(!reached.insert(p).second) return known->second;     //already collected, so it has an id
+
+    if(known != ids.end()) {
+        //all nodes below an exported node have been exported too, they only need to be marked as reached
+        const std::uint32_t id = known->second;
+        for(unsigned int i = 0; i < arity; i++) {
+            const dd::Edge& e = p->e[arity == 2 ? 2 * i : i];
+            if(!CN::equalsZero(e.w) && !dd::Package::isTerminal(e)) collect(e.p, arity, result);
+        }
+        return id;
+    }
+
+    Node node{0, p->v, std::vector<std::uint32_t>(arity), std::vector<fp>(2 * arity)};
+    for(unsigned int i = 0; i < arity; i++) {
+        const dd::Edge& e = p->e[arity == 2 ? 2 * i : i];
+        node.children[i] = CN::equalsZero(e.w) || dd::Package::isTerminal(e) ? 0 : collect(e.p, arity, result);
+        node.weights[2 * i] = CN::val(e.w.r);
+        node.weights[2 * i + 1] = CN::val(e.w.i);
+    }
+    node.id = nextId++;
+    ids.emplace(p, node.id);
+    result.added.push_back(std::move(node));
+    return result.added.back().id;
+}
+
+/**
+ *
+ * @param env the environment to create the object in
+ * @param result a diff
+ * @return null if nothing changed, otherwise {base, version, root: {id, re, im}, added: [{id, level, children, weights}],
+ *          removed: [ids]}
+ */
+Napi::Value DDDiff::toObject(Napi::Env env, const Result& result) {
+    if(!result.changed) return env.Null();
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("base", Napi::Number::New(env, (double)result.base));
+    obj.Set("version", Napi::Number::New(env, (double)result.version));
+
+    Napi::Object root = Napi::Object::New(env);
+    root.Set("id", Napi::Number::New(env, result.root));
+    root.Set("re", Napi::Number::New(env, result.rootRe));
+    root.Set("im", Napi::Number::New(env, result.rootIm));
+    obj.Set("root", root);
+
+    Napi::Array added = Napi::Array::New(env, result.added.size());
+    for(std::size_t i = 0; i < result.added.size(); i++) {
+        const Node& node = result.added[i];
+        Napi::Object n = Napi::Object::New(env);
+        n.Set("id", Napi::Number::New(env, node.id));
+        n.Set("level", Napi::Number::New(env, node.level));
+        Napi::Array children = Napi::Array::New(env, node.children.size());
+        for(std::size_t c = 0; c < node.children.size(); c++) children.Set(c, Napi::Number::New(env, node.children[c]));
+        n.Set("children", children);
+        Napi::Array weights = Napi::Array::New(env, node.weights.size());
+        for(std::size_t w = 0; w < node.weights.size(); w++) weights.Set(w, Napi::Number::New(env, node.weights[w]));
+        n.Set("weights", weights);
+        added.Set(i, n);
+    }
+    obj.Set("added", added);
+
+    Napi::Array removed = Napi::Array::New(env, result.removed.size());
+    for(std::size_t i = 0; i < result.removed.size(); i++) removed.Set(i, Napi::Number::New(env, result.removed[i]));
+    obj.Set("removed", removed);
+    return obj;
+}
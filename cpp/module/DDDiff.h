@@ -0,0 +1,53 @@
+#ifndef QDD_VIS_DDDIFF_H
+#define QDD_VIS_DDDIFF_H
+
+#include <napi.h>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Exports a DD as the difference to the DD exported before, so the client only has to patch its graph instead of
+ * re-parsing the whole DD after every step.
+ * Every exported node gets a stable id (the terminal is always 0). The root of the last export is ref-counted, so none
+ * of its nodes can be collected meanwhile. Since nodes are unique and immutable, a node that is still reachable keeps
+ * its id, children and edge weights, hence a diff only consists of the nodes that were added or removed and the root
+ * edge. Node ids are never reused.
+ */
+class DDDiff {
+public:
+    struct Node {
+        std::uint32_t id;
+        short level;
+        std::vector<std::uint32_t> children;    //ids of the nodes the edges point to
+        std::vector<fp> weights;                //re, im of every edge
+    };
+
+    struct Result {
+        bool changed = false;           //false if the DD is structurally identical to the last export
+        unsigned long long base = 0;    //version the diff has to be applied to (0 = empty graph)
+        unsigned long long version = 0; //version after applying the diff
+        std::uint32_t root = 0;
+        fp rootRe = 0, rootIm = 0;
+        std::vector<Node> added{};      //children always come before their parents
+        std::vector<std::uint32_t> removed{};
+    };
+
+    Result diff(dd::Package& dd, const dd::Edge& root, bool isVector);
+    void clear(dd::Package& dd);
+    static Napi::Value toObject(Napi::Env env, const Result& result);
+
+private:
+    std::uint32_t collect(dd::NodePtr p, unsigned int arity, Result& result);
+
+    dd::Edge exported{};    //root of the last export, nullptr if there is none
+    unsigned long long version = 0;
+    std::uint32_t nextId = 1;
+    std::unordered_map<dd::NodePtr, std::uint32_t> ids{};   //all nodes of the last export
+    std::unordered_set<dd::NodePtr> reached{};              //scratch: nodes of the current export
+};
+
+#endif //QDD_VIS_DDDIFF_H
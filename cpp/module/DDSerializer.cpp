@@ -0,0 +1,114 @@
+
+#include <cstring>
+
+#include "DDSerializer.h"
+
+namespace {
+    void putU32(std::uint8_t* out, std::uint32_t value) {
+        for(int b = 0; b < 4; b++) out[b] = (std::uint8_t)(value >> (8u * b));
+    }
+
+    void putF64(std::uint8_t* out, double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for(int b = 0; b < 8; b++) out[b] = (std::uint8_t)(bits >> (8u * b));
+    }
+}
+
+/**
+ *
+ * @param root the DD to serialize
+ * @param isVector whether root is a vector DD (only e[0] and e[2] of its nodes are stored) or a matrix DD
+ * @return the binary node table described in DDSerializer.h
+ */
+std::vector<std::uint8_t> DDSerializer::serialize(const dd::Edge& root, bool isVector) {
+    DDSerializer serializer(isVector);
+    serializer.weight(CN::ZERO);
+    serializer.weight(CN::ONE);
+
+    const std::uint32_t rootWeight = serializer.weight(root.w);
+    const std::uint32_t rootNode = CN::equalsZero(root.w) || dd::Package::isTerminal(root) ? NO_NODE : serializer.node(root.p);
+    return serializer.finish(rootNode, rootWeight);
+}
+
+/**Appends the given node and all nodes below it to the node section (each node only once).
+ *
+ * @param p a non-terminal node
+ * @return index of p in the node section
+ */
+std::uint32_t DDSerializer::node(dd::NodePtr p) {
+    auto it = nodeIndex.find(p);
+    if(it != nodeIndex.end()) return it->second;
+
+    std::uint32_t children[4][2];
+    for(unsigned int i = 0; i < arity; i++) {
+        const dd::Edge& e = p->e[arity == 2 ? 2 * i : i];
+        children[i][1] = weight(e.w);
+        children[i][0] = CN::equalsZero(e.w) || dd::Package::isTerminal(e) ? NO_NODE : node(e.p);
+    }
+
+    const auto index = (std::uint32_t)(nodes.size() / (1 + 2 * arity));
+    nodes.push_back((std::uint32_t)p->v);
+    for(unsigned int i = 0; i < arity; i++) {
+        nodes.push_back(children[i][0]);
+        nodes.push_back(children[i][1]);
+    }
+    nodeIndex.emplace(p, index);
+    return index;
+}
+
+/**
+ *
+ * @param w an edge weight whose parts are entries of the complex table
+ * @return index of w in the weight section
+ */
+std::uint32_t DDSerializer::weight(const dd::Complex& w) {
+    auto it = weightIndex.find(std::make_pair(w.r, w.i));
+    if(it != weightIndex.end()) return it->second;
+
+    const auto index = (std::uint32_t)weights.size();
+    weights.emplace_back(CN::val(w.r), CN::val(w.i));
+    weightIndex.emplace(std::make_pair(w.r, w.i), index);
+    return index;
+}
+
+/**Hands a serialized DD over to JS without copying it. The ArrayBuffer keeps the bytes alive until it is collected,
+ * they may be shared with the export cache, so JS has to treat them as read-only.
+ *
+ * @param env the environment to create the array in
+ * @param bytes result of serialize
+ * @return Uint8Array backed by the given bytes
+ */
+Napi::Value DDSerializer::toUint8Array(Napi::Env env, const std::shared_ptr<const std::vector<std::uint8_t>>& bytes) {
+    auto* owner = new std::shared_ptr<const std::vector<std::uint8_t>>(bytes);
+    Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, const_cast<std::uint8_t*>(bytes->data()), bytes->size(),
+            [owner](Napi::Env /*env*/, void* /*data*/) { delete owner; });
+    return Napi::Uint8Array::New(env, bytes->size(), buffer, 0);
+}
+
+std::vector<std::uint8_t> DDSerializer::finish(std::uint32_t rootNode, std::uint32_t rootWeight) const {
+    const auto nodeCount = (std::uint32_t)(nodes.size() / (1 + 2 * arity));
+    std::vector<std::uint8_t> out(HEADER_SIZE + 16 * weights.size() + 4 * nodes.size());
+
+    std::uint8_t* pos = out.data();
+    std::memcpy(pos, "QDDB", 4);
+    pos[4] = VERSION;
+    pos[5] = (std::uint8_t)arity;
+    pos[6] = pos[7] = 0;
+    putU32(pos + 8, nodeCount);
+    putU32(pos + 12, (std::uint32_t)weights.size());
+    putU32(pos + 16, rootNode);
+    putU32(pos + 20, rootWeight);
+    pos += HEADER_SIZE;
+
+    for(const auto& w : weights) {
+        putF64(pos, w.first);
+        putF64(pos + 8, w.second);
+        pos += 16;
+    }
+    for(std::uint32_t value : nodes) {
+        putU32(pos, value);
+        pos += 4;
+    }
+    return out;
+}
@@ -0,0 +1,47 @@
+#ifndef QDD_VIS_DDSERIALIZER_H
+#define QDD_VIS_DDSERIALIZER_H
+
+#include <napi.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Serializes a DD into a compact binary node table as an alternative to the .dot-export. All values are little-endian:
+ *
+ *  header (24 bytes):  "QDDB", u8 version, u8 arity (2 for vectors, 4 for matrices), u16 reserved,
+ *                      u32 #nodes, u32 #weights, u32 root node, u32 root weight
+ *  weights:            #weights times (f64 re, f64 im), weight 0 is always 0 and weight 1 is always 1
+ *  nodes:              #nodes times (u32 level, arity times (u32 child node, u32 weight))
+ *
+ * Children are stored before their parents and NO_NODE stands for the terminal. Edge weights are interned by the
+ * entries of the complex table, so every distinct weight is only stored once.
+ */
+class DDSerializer {
+public:
+    static constexpr std::uint8_t VERSION = 1;
+    static constexpr std::uint32_t NO_NODE = 0xFFFFFFFFu;
+    static constexpr std::size_t HEADER_SIZE = 24;
+
+    static std::vector<std::uint8_t> serialize(const dd::Edge& root, bool isVector);
+    static Napi::Value toUint8Array(Napi::Env env, const std::shared_ptr<const std::vector<std::uint8_t>>& bytes);
+
+private:
+    DDSerializer(bool isVector) : arity(isVector ? 2 : 4) {}
+
+    std::uint32_t node(dd::NodePtr p);
+    std::uint32_t weight(const dd::Complex& w);
+    std::vector<std::uint8_t> finish(std::uint32_t rootNode, std::uint32_t rootWeight) const;
+
+    const unsigned int arity;
+    std::unordered_map<dd::NodePtr, std::uint32_t> nodeIndex{};
+    std::map<std::pair<const dd::ComplexTableEntry*, const dd::ComplexTableEntry*>, std::uint32_t> weightIndex{};
+    std::vector<std::pair<fp, fp>> weights{};
+    std::vector<std::uint32_t> nodes{};     //already in the layout of the node section
+};
+
+#endif //QDD_VIS_DDSERIALIZER_H
@@ -0,0 +1,72 @@
+#include <cmath>
+
+#include "Equivalence.h"
+
+/**
+ *
+ * @param name one of "naive", "oneToOne", "proportional" and "lookahead"
+ * @param strategy is set to the strategy of the given name
+ * @return false if the name is unknown (strategy stays unchanged), true otherwise
+ */
+bool Equivalence::parseStrategy(const std::string& name, Strategy& strategy) {
+    if(name == "naive")             strategy = Strategy::Naive;
+    else if(name == "oneToOne")     strategy = Strategy::OneToOne;
+    else if(name == "proportional") strategy = Strategy::Proportional;
+    else if(name == "lookahead")    strategy = Strategy::Lookahead;
+    else return false;
+    return true;
+}
+
+const char* Equivalence::strategyName(Strategy strategy) {
+    switch(strategy) {
+        case Strategy::Naive:           return "naive";
+        case Strategy::OneToOne:        return "oneToOne";
+        case Strategy::Proportional:    return "proportional";
+        case Strategy::Lookahead:       return "lookahead";
+    }
+    return "";
+}
+
+const char* Equivalence::verdictName(Verdict verdict) {
+    switch(verdict) {
+        case Verdict::Equivalent:                   return "equivalent";
+        case Verdict::EquivalentUpToGlobalPhase:    return "equivalentUpToGlobalPhase";
+        case Verdict::NotEquivalent:                return "notEquivalent";
+        case Verdict::NoInformation:                return "noInformation";
+        case Verdict::NotYet:                       return "notYet";
+    }
+    return "";
+}
+
+/**Since DDs are canonical, the result is the identity exactly if it points to the same node, and the weight of its
+ * root edge is the global phase.
+ *
+ * @param result the DD after all operations of both algorithms have been applied
+ * @param identity the DD the check started with (the identity, reduced by the ancillae of the algorithms)
+ * @return whether result is the identity, the identity up to a global phase or something else
+ */
+Equivalence::Verdict Equivalence::compare(const dd::Edge& result, const dd::Edge& identity) {
+    if(result.p != identity.p) return Verdict::NotEquivalent;
+    if(CN::equals(result.w, identity.w)) return Verdict::Equivalent;
+    if(std::abs(CN::mag(result.w) - CN::mag(identity.w)) < TOLERANCE) return Verdict::EquivalentUpToGlobalPhase;
+    return Verdict::NotEquivalent;
+}
+
+/**
+ *
+ * @param env the environment the object is created in
+ * @param result the result of a check
+ * @return object with members strategy, verdict (names as in strategyName and verdictName), peakNodes, ops,
+ *          time (in µs), cancelled and stimuli (as in Stimuli::toObject, only if the pre-check was done)
+ */
+Napi::Object Equivalence::toObject(Napi::Env env, const Result& result) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("strategy", Napi::String::New(env, strategyName(result.strategy)));
+    obj.Set("verdict", Napi::String::New(env, verdictName(result.verdict)));
+    obj.Set("peakNodes", Napi::Number::New(env, result.peakNodes));
+    obj.Set("ops", Napi::Number::New(env, result.ops));
+    obj.Set("time", Napi::Number::New(env, result.time));
+    obj.Set("cancelled", Napi::Boolean::New(env, result.cancelled));
+    if(result.withStimuli) obj.Set("stimuli", Stimuli::toObject(env, result.stimuli));
+    return obj;
+}
@@ -0,0 +1,54 @@
+#ifndef QDD_VIS_EQUIVALENCE_H
+#define QDD_VIS_EQUIVALENCE_H
+
+#include <napi.h>
+#include <string>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+#include "Stimuli.h"
+
+/**Strategies and results of the automatic equivalence check of QDDVer. The check applies the remaining operations of
+ * algo1 from the left and the inverses of the remaining operations of algo2 from the right until both are at their end;
+ * the algorithms are equivalent if the result is the identity again. The strategy decides which side is applied next:
+ * the DD stays much closer to the identity (and therefore much smaller) if both sides progress at the same pace.
+ */
+class Equivalence {
+public:
+    enum class Strategy {
+        Naive,          //all operations of algo1, then all of algo2
+        OneToOne,       //alternates between the two algorithms
+        Proportional,   //keeps the progress of both algorithms proportional to their number of operations
+        Lookahead       //tries both sides and applies the one that results in the smaller DD
+    };
+
+    enum class Verdict {
+        Equivalent,
+        EquivalentUpToGlobalPhase,
+        NotEquivalent,
+        NoInformation,  //the check was cancelled before both algorithms were at their end
+        NotYet          //not the identity, but not all operations have been applied yet (only while stepping)
+    };
+
+    struct Result {
+        Strategy strategy = Strategy::Proportional;
+        Verdict verdict = Verdict::NoInformation;
+        unsigned int peakNodes = 0;     //most active nodes of the package after an operation while checking (the DD
+                                        //and everything kept alongside it, like checkpoints and cached gates)
+        unsigned long long ops = 0;     //number of applied operations (of both algorithms together)
+        long long time = 0;             //in µs, including the pre-check
+        bool cancelled = false;
+        bool withStimuli = false;       //whether the random stimuli were checked before the matrices
+        Stimuli::Result stimuli{};      //result of this pre-check
+    };
+
+    static constexpr fp TOLERANCE = 1e-10;  //for comparing the magnitude of the global phase with 1
+
+    static bool parseStrategy(const std::string& name, Strategy& strategy);
+    static const char* strategyName(Strategy strategy);
+    static const char* verdictName(Verdict verdict);
+    static Verdict compare(const dd::Edge& result, const dd::Edge& identity);
+    static Napi::Object toObject(Napi::Env env, const Result& result);
+};
+
+#endif //QDD_VIS_EQUIVALENCE_H
@@ -0,0 +1,95 @@
+
+#include "ExportCache.h"
+
+/**
+ *
+ * @param dd the package root belongs to
+ * @param root the DD to export
+ * @param options the export options the .dot-output depends on (as bitmask)
+ * @param create produces the .dot-output if it isn't cached yet
+ * @return the .dot-output of root for the given options
+ */
+ExportCache::Dot ExportCache::dot(dd::Package& dd, const dd::Edge& root, unsigned int options,
+                                  const std::function<std::string()>& create) {
+    Entry& e = entry(dd, root);
+    auto it = e.dots.find(options);
+    if(it != e.dots.end()) {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+    Dot output = std::make_shared<const std::string>(create());
+    e.dots.emplace(options, output);
+    bytes += output->size();
+    shrink(dd);
+    return output;
+}
+
+/**
+ *
+ * @param dd the package root belongs to
+ * @param root the DD to export
+ * @param create produces the binary output if it isn't cached yet
+ * @return the binary output of root (shared with the cache, so it must not be modified)
+ */
+ExportCache::Binary ExportCache::binary(dd::Package& dd, const dd::Edge& root,
+                                        const std::function<std::vector<std::uint8_t>()>& create) {
+    Entry& e = entry(dd, root);
+    if(e.binary) {
+        hits++;
+        return e.binary;
+    }
+
+    misses++;
+    e.binary = std::make_shared<const std::vector<std::uint8_t>>(create());
+    bytes += e.binary->size();
+    Binary output = e.binary;
+    shrink(dd);
+    return output;
+}
+
+/**Removes all entries, e.g. before the package is reset.
+ *
+ * @param dd the package the cached roots belong to
+ */
+void ExportCache::clear(dd::Package& dd) {
+    for(Entry& e : entries) dd.decRef(e.root);
+    entries.clear();
+    bytes = 0;
+}
+
+/**
+ *
+ * @param dd the package root belongs to
+ * @param root the DD to export
+ * @return the entry of root, which is created if necessary and moved to the front of the usage order
+ */
+ExportCache::Entry& ExportCache::entry(dd::Package& dd, const dd::Edge& root) {
+    for(auto it = entries.begin(); it != entries.end(); ++it) {
+        if(dd::Package::equals(it->root, root)) {
+            entries.splice(entries.begin(), entries, it);
+            return entries.front();
+        }
+    }
+
+    entries.emplace_front();
+    entries.front().root = root;
+    dd.incRef(entries.front().root);
+    return entries.front();
+}
+
+/**Evicts the least recently used entries until at most MAX_ENTRIES and MAX_BYTES are left. The most recently used
+ * entry is always kept.
+ *
+ * @param dd the package the cached roots belong to
+ */
+void ExportCache::shrink(dd::Package& dd) {
+    while(entries.size() > 1 && (entries.size() > MAX_ENTRIES || bytes > MAX_BYTES)) {
+        Entry& e = entries.back();
+        for(const auto& d : e.dots) bytes -= d.second->size();
+        if(e.binary) bytes -= e.binary->size();
+        dd.decRef(e.root);
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef QDD_VIS_EXPORTCACHE_H
+#define QDD_VIS_EXPORTCACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Keeps the serialized forms (.dot per combination of export options and the binary node table) of the last exported
+ * DDs, so viewing the same state again doesn't serialize it again. Entries are keyed by the root edge, which is
+ * ref-counted as long as the entry exists: its nodes can't be collected, hence a node pointer can't be reused for a
+ * different node while it is part of a key. At most MAX_ENTRIES roots and MAX_BYTES of output are kept, the least
+ * recently used roots are evicted first.
+ */
+class ExportCache {
+public:
+    using Dot = std::shared_ptr<const std::string>;
+    using Binary = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+    static constexpr std::size_t MAX_ENTRIES = 8;
+    static constexpr std::size_t MAX_BYTES = 64u << 20u;
+
+    Dot dot(dd::Package& dd, const dd::Edge& root, unsigned int options, const std::function<std::string()>& create);
+    Binary binary(dd::Package& dd, const dd::Edge& root, const std::function<std::vector<std::uint8_t>()>& create);
+    void clear(dd::Package& dd);
+
+    unsigned long long getHits() const { return hits; }
+    unsigned long long getMisses() const { return misses; }
+    std::size_t size() const { return entries.size(); }
+    std::size_t getBytes() const { return bytes; }
+
+private:
+    struct Entry {
+        dd::Edge root{};
+        std::map<unsigned int, Dot> dots{};     //keyed by the export options
+        Binary binary{};
+    };
+
+    Entry& entry(dd::Package& dd, const dd::Edge& root);
+    void shrink(dd::Package& dd);
+
+    std::list<Entry> entries{};     //most recently used first
+    std::size_t bytes = 0;          //size of all cached outputs together
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+};
+
+#endif //QDD_VIS_EXPORTCACHE_H
@@ -0,0 +1,79 @@
+
+#include <chrono>
+
+#include "GCPolicy.h"
+
+/**Has to be called after every multiplication that replaced the simulation state.
+ *
+ * @param dd the package to collect
+ */
+void GCPolicy::afterStep(dd::Package& dd) {
+    ++stepsSinceCollection;
+    switch(mode) {
+        case Mode::EveryStep:
+            collect(dd, false);
+            break;
+        case Mode::EveryNSteps:
+            if(stepsSinceCollection >= parameter) collect(dd, true);
+            break;
+        case Mode::NodeThreshold:
+            if(dd.nodecount > parameter) collect(dd, true);
+            break;
+        case Mode::EndOfBatch:
+            break;
+    }
+}
+
+/**Has to be called at the end of every call that (might have) processed operations. Collects if any step since the
+ * last collection has been left uncollected by the policy.
+ *
+ * @param dd the package to collect
+ */
+void GCPolicy::endOfBatch(dd::Package& dd) {
+    if(mode != Mode::EveryStep && stepsSinceCollection > 0) collect(dd, true);
+}
+
+/**
+ *
+ * @param name one of "everyStep", "everyNSteps", "nodeThreshold" and "endOfBatch"
+ * @param parameter number of steps for everyNSteps, number of nodes for nodeThreshold, ignored otherwise
+ * @return false if the name is unknown or the parameter is invalid (the policy stays unchanged), true otherwise
+ */
+bool GCPolicy::setMode(const std::string& name, unsigned long parameter) {
+    Mode newMode;
+    if(name == "everyStep")             newMode = Mode::EveryStep;
+    else if(name == "everyNSteps")      newMode = Mode::EveryNSteps;
+    else if(name == "nodeThreshold")    newMode = Mode::NodeThreshold;
+    else if(name == "endOfBatch")       newMode = Mode::EndOfBatch;
+    else return false;
+
+    if((newMode == Mode::EveryNSteps || newMode == Mode::NodeThreshold) && parameter == 0) return false;
+
+    this->mode = newMode;
+    this->parameter = parameter;
+    return true;
+}
+
+const char* GCPolicy::modeName(Mode mode) {
+    switch(mode) {
+        case Mode::EveryStep:       return "everyStep";
+        case Mode::EveryNSteps:     return "everyNSteps";
+        case Mode::NodeThreshold:   return "nodeThreshold";
+        case Mode::EndOfBatch:      return "endOfBatch";
+    }
+    return "";
+}
+
+void GCPolicy::collect(dd::Package& dd, bool force) {
+    const unsigned long before = dd.nodecount;
+    const auto start = std::chrono::steady_clock::now();
+    dd.garbageCollect(force);
+    const auto end = std::chrono::steady_clock::now();
+
+    stepsSinceCollection = 0;
+    time += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    if(force || dd.nodecount < before) {    //without force the package only collects if its own limits are exceeded
+        ++runs;
+        if(dd.nodecount < before) nodesFreed += before - dd.nodecount;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef QDD_VIS_GCPOLICY_H
+#define QDD_VIS_GCPOLICY_H
+
+#include <string>
+
+#include "DDpackage.h"
+
+/**Decides when the garbage collection of a package runs while stepping through an algorithm. Collecting after every
+ * multiplication keeps the peak memory low, while collecting less often speeds up bulk stepping (ToEnd, ToLine).
+ * Counts how often a collection ran, how many nodes it freed and how much time it took, so both can be traded off.
+ */
+class GCPolicy {
+public:
+    enum class Mode {
+        EveryStep,      //let the package decide after every step (its own limits apply)
+        EveryNSteps,    //force a collection after every parameter steps
+        NodeThreshold,  //force a collection as soon as the unique table holds more than parameter nodes
+        EndOfBatch      //force a collection only at the end of a call (e.g. after ToEnd processed all operations)
+    };
+
+    void afterStep(dd::Package& dd);
+    void endOfBatch(dd::Package& dd);
+
+    bool setMode(const std::string& name, unsigned long parameter);
+    Mode getMode() const { return mode; }
+    unsigned long getParameter() const { return parameter; }
+    static const char* modeName(Mode mode);
+
+    unsigned long long getRuns() const { return runs; }
+    unsigned long long getNodesFreed() const { return nodesFreed; }
+    unsigned long long getTime() const { return time; }
+
+private:
+    void collect(dd::Package& dd, bool force);
+
+    Mode mode = Mode::EveryStep;
+    unsigned long parameter = 0;
+    unsigned long stepsSinceCollection = 0;
+
+    unsigned long long runs = 0;        //how often the package actually collected
+    unsigned long long nodesFreed = 0;
+    unsigned long long time = 0;        //in µs, spent in garbageCollect() (including calls that freed nothing)
+};
+
+#endif //QDD_VIS_GCPOLICY_H
@@ -0,0 +1,83 @@
+
+#include "GateCache.h"
+
+/**
+ *
+ * @param index index of the operation in the loaded algorithm
+ * @param inverse whether we want the inverse DD of the operation
+ * @param gate is set to the stored DD if there is one
+ * @return true if the DD was stored (hit), false otherwise (miss)
+ */
+bool GateCache::lookup(unsigned int index, bool inverse, dd::Edge& gate) {
+    auto it = entries.find(Key{index, inverse});
+    if(it == entries.end()) {
+        ++misses;
+        return false;
+    }
+
+    ++hits;
+    usage.splice(usage.begin(), usage, it->second.use);
+    gate = it->second.gate;
+    return true;
+}
+
+/**Stores the given DD and evicts the least recently used ones if the node budget is exceeded afterwards. DDs that are
+ * bigger than the whole budget are not stored at all.
+ *
+ * @param dd the package the DD belongs to
+ * @param index index of the operation in the loaded algorithm
+ * @param inverse whether gate is the inverse DD of the operation
+ * @param gate the DD of the operation
+ */
+void GateCache::store(dd::Package& dd, unsigned int index, bool inverse, const dd::Edge& gate) {
+    const Key key{index, inverse};
+    auto it = entries.find(key);
+    if(it != entries.end()) evict(dd, it);
+
+    const unsigned int size = dd.size(gate);
+    if(size > MAX_NODES) return;
+
+    Entry entry;
+    entry.gate = gate;
+    entry.nodes = size;
+    dd.incRef(entry.gate);
+    usage.push_front(key);
+    entry.use = usage.begin();
+    entries.emplace(key, entry);
+    nodes += size;
+
+    while(nodes > MAX_NODES) evict(dd, entries.find(usage.back()));
+}
+
+/**Removes the stored DDs of all operations from the given index on, e.g. because an edited algorithm has been loaded
+ * whose operations only match up to this index.
+ *
+ * @param dd the package the DDs belong to
+ * @param index index of the first operation whose DDs are removed
+ */
+void GateCache::dropFrom(dd::Package& dd, unsigned int index) {
+    auto it = entries.lower_bound(Key{index, false});
+    while(it != entries.end()) {
+        auto next = std::next(it);
+        evict(dd, it);
+        it = next;
+    }
+}
+
+/**Removes all stored DDs, e.g. because a new algorithm has been loaded. The counters are kept.
+ *
+ * @param dd the package the DDs belong to
+ */
+void GateCache::clear(dd::Package& dd) {
+    for(auto& entry : entries) dd.decRef(entry.second.gate);
+    entries.clear();
+    usage.clear();
+    nodes = 0;
+}
+
+void GateCache::evict(dd::Package& dd, std::map<Key, Entry>::iterator it) {
+    dd.decRef(it->second.gate);
+    nodes -= it->second.nodes;
+    usage.erase(it->second.use);
+    entries.erase(it);
+}
@@ -0,0 +1,47 @@
+#ifndef QDD_VIS_GATECACHE_H
+#define QDD_VIS_GATECACHE_H
+
+#include <list>
+#include <map>
+#include <utility>
+
+#include "DDpackage.h"
+
+/**Keeps the DDs of the operations of the loaded algorithm (forward and inverse) so stepping over the same operation
+ * again only costs the multiplication. Entries are keyed by the index of the operation, hence the entries from the
+ * first changed operation on have to be dropped whenever a new algorithm is loaded. All stored DDs are ref-counted
+ * until they are evicted, and the least recently used ones are evicted as soon as the stored DDs together have more
+ * than MAX_NODES nodes.
+ */
+class GateCache {
+public:
+    static constexpr unsigned int MAX_NODES = 1u << 16;  //node budget of all stored DDs together
+
+    bool lookup(unsigned int index, bool inverse, dd::Edge& gate);
+    void store(dd::Package& dd, unsigned int index, bool inverse, const dd::Edge& gate);
+    void dropFrom(dd::Package& dd, unsigned int index);
+    void clear(dd::Package& dd);
+
+    unsigned long long getHits() const { return hits; }
+    unsigned long long getMisses() const { return misses; }
+    std::size_t size() const { return entries.size(); }
+    unsigned int getNodes() const { return nodes; }
+
+private:
+    using Key = std::pair<unsigned int, bool>;  //index of the operation, whether it is the inverse
+    struct Entry {
+        dd::Edge gate{};
+        unsigned int nodes = 0;
+        std::list<Key>::iterator use{};     //position in the usage order
+    };
+
+    void evict(dd::Package& dd, std::map<Key, Entry>::iterator it);
+
+    std::map<Key, Entry> entries{};
+    std::list<Key> usage{};     //most recently used first
+    unsigned int nodes = 0;     //sum of the nodes of all stored DDs
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+};
+
+#endif //QDD_VIS_GATECACHE_H
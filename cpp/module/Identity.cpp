@@ -0,0 +1,94 @@
+#include <vector>
+
+#include "Identity.h"
+
+/**Replaces the stored identity with the given one.
+ *
+ * @param dd the package the DD belongs to
+ * @param identity the DD the verification starts with, it stays ref-counted until clear() is called
+ */
+void Identity::set(dd::Package& dd, const dd::Edge& identity) {
+    clear(dd);
+    edge = identity;
+    dd.incRef(edge);
+
+    //the identity has one node per qubit (at most), so collecting them is cheap
+    std::vector<dd::NodePtr> stack{edge.p};
+    while(!stack.empty()) {
+        dd::NodePtr p = stack.back();
+        stack.pop_back();
+        if(p == nullptr || p == dd::Package::terminalNode || !nodes.insert(p).second) continue;
+        for(const dd::Edge& child : p->e) stack.push_back(child.p);
+    }
+}
+
+void Identity::clear(dd::Package& dd) {
+    if(tracked.p != nullptr) dd.decRef(tracked);
+    tracked = dd::Edge{};
+    parents.clear();
+    if(edge.p != nullptr) dd.decRef(edge);
+    edge = dd::Edge{};
+    nodes.clear();
+}
+
+/**
+ *
+ * @param e the current state of the verification
+ * @return Equivalent or EquivalentUpToGlobalPhase if e is the identity, NotEquivalent otherwise (also if no identity
+ *          is stored)
+ */
+Equivalence::Verdict Identity::compare(const dd::Edge& e) const {
+    if(empty()) return Equivalence::Verdict::NotEquivalent;
+    return Equivalence::compare(e, edge);
+}
+
+/**Counts the nodes of e that are not part of the identity, incrementally from the previously tracked state: only the
+ * nodes of e that weren't part of it are visited (until the traversal reaches a known node or the identity), and only
+ * the nodes of it that aren't part of e anymore. After a step this is about the nodes the multiplication created,
+ * while the shared rest of the DD isn't touched.
+ *
+ * @param dd the package e belongs to
+ * @param e the current state of the verification, it stays ref-counted until the next call or clear()
+ * @return number of distinct non-terminal nodes of e that are not nodes of the identity (0 if e is the identity)
+ */
+unsigned int Identity::track(dd::Package& dd, const dd::Edge& e) {
+    if(tracked.p == e.p) return (unsigned int)parents.size();
+    add(e.p);       //first, so nodes shared with the previous state never drop to 0 parents
+    remove(tracked.p);
+    if(tracked.p != nullptr) dd.decRef(tracked);
+    tracked = e;
+    if(tracked.p != nullptr) dd.incRef(tracked);
+    return (unsigned int)parents.size();
+}
+
+/**Adds a parent to the given node, and to its children if the node wasn't part of the tracked state before.
+ *
+ * @param p root of the sub-DD that is added
+ */
+void Identity::add(dd::NodePtr p) {
+    std::vector<dd::NodePtr> stack{p};
+    while(!stack.empty()) {
+        p = stack.back();
+        stack.pop_back();
+        if(p == nullptr || p == dd::Package::terminalNode || nodes.count(p) > 0) continue;
+        if(parents[p]++ > 0) continue;
+        for(const dd::Edge& child : p->e) stack.push_back(child.p);
+    }
+}
+
+/**Removes a parent from the given node, and from its children if the node isn't part of the tracked state anymore.
+ *
+ * @param p root of the sub-DD that is removed
+ */
+void Identity::remove(dd::NodePtr p) {
+    std::vector<dd::NodePtr> stack{p};
+    while(!stack.empty()) {
+        p = stack.back();
+        stack.pop_back();
+        if(p == nullptr || p == dd::Package::terminalNode || nodes.count(p) > 0) continue;
+        auto it = parents.find(p);
+        if(it == parents.end() || --it->second > 0) continue;
+        parents.erase(it);
+        for(const dd::Edge& child : p->e) stack.push_back(child.p);
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef QDD_VIS_IDENTITY_H
+#define QDD_VIS_IDENTITY_H
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "DDpackage.h"
+#include "Equivalence.h"
+
+/**The identity QDDVer started with (reduced by the ancillae of the algorithms), kept ref-counted for the whole
+ * verification. Since DDs are canonical, every node of the identity is unique in the package, so whether sim is the
+ * identity is a pointer comparison and the non-identity part of sim ends wherever it reaches one of these nodes.
+ * The non-identity nodes of the last tracked state are counted like the package counts references (how many parents
+ * within the state each node has), so tracking the next state only visits the nodes that were added or dropped.
+ */
+class Identity {
+public:
+    void set(dd::Package& dd, const dd::Edge& identity);
+    void clear(dd::Package& dd);
+    bool empty() const { return edge.p == nullptr; }
+    const dd::Edge& get() const { return edge; }
+
+    Equivalence::Verdict compare(const dd::Edge& e) const;
+    unsigned int track(dd::Package& dd, const dd::Edge& e);
+
+private:
+    void add(dd::NodePtr p);
+    void remove(dd::NodePtr p);
+
+    dd::Edge edge{};
+    std::unordered_set<dd::NodePtr> nodes{};    //all non-terminal nodes of edge
+    dd::Edge tracked{};     //the state parents belongs to, ref-counted so its nodes stay valid
+    std::unordered_map<dd::NodePtr, unsigned int> parents{};   //non-identity nodes of tracked and their parents in it
+};
+
+#endif //QDD_VIS_IDENTITY_H
@@ -0,0 +1,195 @@
+
+#include <algorithm>
+
+#include "Layout.h"
+
+/**
+ *
+ * @param dd the package root belongs to
+ * @param root the DD to lay out
+ * @param isVector whether root is a vector DD (only e[0] and e[2] of its nodes are drawn) or a matrix DD
+ * @return coordinates of all nodes and the edges between them
+ */
+Layout::Result Layout::layout(dd::Package& dd, const dd::Edge& root, bool isVector) {
+    arity = isVector ? 2 : 4;
+    std::vector<Vertex> vertices;
+    //the terminal is always at index 0
+    vertices.push_back(Vertex{dd::Package::terminalNode, 0, 0, false, 0, 0});
+    const bool empty = CN::equalsZero(root.w) || dd::Package::isTerminal(root);
+    const int rootIndex = empty ? 0 : collect(root.p, vertices);
+    visited.clear();
+
+    //the layers are counted from the root, the terminal gets its own layer below the lowest level
+    const short topLevel = empty ? -1 : root.p->v;
+    std::vector<std::vector<int>> layers(topLevel + 2);
+    vertices[0].layer = topLevel + 1;
+    for(std::size_t i = 0; i < vertices.size(); i++) {
+        if(i > 0) vertices[i].layer = topLevel - vertices[i].p->v;
+        layers[vertices[i].layer].push_back((int)i);
+    }
+    //initial placement in the order the nodes were found (0-edges first), new nodes at their index
+    for(auto& layer : layers) {
+        for(std::size_t pos = 0; pos < layer.size(); pos++) {
+            Vertex& v = vertices[layer[pos]];
+            if(!v.anchored) v.x = v.key = ((double)pos - (double)(layer.size() - 1) / 2) * NODE_SPACING;
+        }
+        place(vertices, layer);
+    }
+
+    for(unsigned int sweep = 0; sweep < SWEEPS; sweep++) {
+        const bool down = sweep % 2 == 0;
+        for(std::size_t l = 1; l < layers.size(); l++) {
+            auto& layer = layers[down ? l : layers.size() - 1 - l];
+            for(int i : layer) {
+                Vertex& v = vertices[i];
+                if(v.anchored) continue;    //keeps its previous x as barycenter
+                const auto& neighbours = down ? v.parents : v.children;
+                if(neighbours.empty()) continue;
+                double sum = 0;
+                for(const auto& n : neighbours) {
+                    sum += vertices[n.first].x + (down ? portOffset(n.second) : -portOffset(n.second));
+                }
+                v.key = sum / (double)neighbours.size();
+            }
+            place(vertices, layer);
+        }
+    }
+
+    Result result;
+    std::unordered_map<dd::NodePtr, std::pair<std::uint32_t, double>> current;
+    for(const auto& layer : layers) {
+        for(int i : layer) {
+            const Vertex& v = vertices[i];
+            result.nodes.push_back(Node{v.id, (short)(i == 0 ? -1 : v.p->v), v.x, v.layer * LAYER_SPACING});
+            if(i > 0) current.emplace(v.p, std::make_pair(v.id, v.x));
+        }
+    }
+    result.root = vertices[rootIndex].id;
+    result.rootRe = CN::val(root.w.r);
+    result.rootIm = CN::val(root.w.i);
+    for(std::size_t i = 1; i < vertices.size(); i++) {
+        for(const auto& c : vertices[i].children) {
+            const dd::Edge& e = vertices[i].p->e[arity == 2 ? 2 * c.second : c.second];
+            result.edges.push_back(Edge{vertices[i].id, vertices[c.first].id, c.second, CN::val(e.w.r), CN::val(e.w.i)});
+        }
+    }
+
+    dd::Edge next = root;
+    dd.incRef(next);
+    if(laidOut.p != nullptr) dd.decRef(laidOut);
+    laidOut = next;
+    previous.swap(current);
+    return result;
+}
+
+/**Forgets the previous layout, so the next one starts from scratch.
+ *
+ * @param dd the package the previous layout belongs to
+ */
+void Layout::clear(dd::Package& dd) {
+    if(laidOut.p != nullptr) dd.decRef(laidOut);
+    laidOut = dd::Edge{};
+    previous.clear();
+}
+
+/**Appends the given node and all nodes below it to vertices (each node only once) and connects them.
+ *
+ * @param p a non-terminal node
+ * @param vertices the found nodes are appended to it
+ * @return index of p in vertices
+ */
+int Layout::collect(dd::NodePtr p, std::vector<Vertex>& vertices) {
+    auto it = visited.find(p);
+    if(it != visited.end()) return it->second;
+
+    const int index = (int)vertices.size();
+    auto prev = previous.find(p);
+    if(prev != previous.end()) {
+        vertices.push_back(Vertex{p, prev->second.first, 0, true, prev->second.second, prev->second.second});
+    } else {
+        vertices.push_back(Vertex{p, nextId++, 0, false, 0, 0});
+    }
+    visited.emplace(p, index);
+
+    for(unsigned short i = 0; i < arity; i++) {
+        const dd::Edge& e = p->e[arity == 2 ? 2 * i : i];
+        if(CN::equalsZero(e.w)) continue;
+        const int child = dd::Package::isTerminal(e) ? 0 : collect(e.p, vertices);
+        vertices[index].children.emplace_back(child, i);
+        vertices[child].parents.emplace_back(index, i);
+    }
+    return index;
+}
+
+/**Orders the given layer by the keys of its nodes and sets their x-coordinates as close to the keys as possible while
+ * keeping NODE_SPACING between neighbours.
+ *
+ * @param vertices all nodes of the DD
+ * @param layer indices of the nodes of one layer, is sorted by this call
+ */
+void Layout::place(std::vector<Vertex>& vertices, std::vector<int>& layer) const {
+    std::stable_sort(layer.begin(), layer.end(), [&vertices](int a, int b) { return vertices[a].key < vertices[b].key; });
+
+    const std::size_t n = layer.size();
+    std::vector<double> left(n), right(n);
+    for(std::size_t i = 0; i < n; i++) {
+        const double key = vertices[layer[i]].key;
+        left[i] = i == 0 ? key : std::max(key, left[i - 1] + NODE_SPACING);
+    }
+    for(std::size_t i = n; i-- > 0; ) {
+        const double key = vertices[layer[i]].key;
+        right[i] = i == n - 1 ? key : std::min(key, right[i + 1] - NODE_SPACING);
+    }
+    for(std::size_t i = 0; i < n; i++) vertices[layer[i]].x = (left[i] + right[i]) / 2;
+}
+
+/**
+ *
+ * @param index index of an edge
+ * @return horizontal distance of the edge's port from the center of its node
+ */
+double Layout::portOffset(unsigned short index) const {
+    return ((double)index - (double)(arity - 1) / 2) * NODE_SPACING / (2.0 * arity);
+}
+
+/**
+ *
+ * @param env the environment to create the object in
+ * @param result a layout
+ * @return {root: {id, re, im}, nodes: [{id, level, x, y}], edges: [{from, to, index, re, im}]}
+ */
+Napi::Value Layout::toObject(Napi::Env env, const Result& result) {
+    Napi::Array nodes = Napi::Array::New(env, result.nodes.size());
+    for(std::size_t i = 0; i < result.nodes.size(); i++) {
+        const Node& node = result.nodes[i];
+        Napi::Object n = Napi::Object::New(env);
+        n.Set("id", Napi::Number::New(env, node.id));
+        n.Set("level", Napi::Number::New(env, node.level));
+        n.Set("x", Napi::Number::New(env, node.x));
+        n.Set("y", Napi::Number::New(env, node.y));
+        nodes.Set(i, n);
+    }
+
+    Napi::Array edges = Napi::Array::New(env, result.edges.size());
+    for(std::size_t i = 0; i < result.edges.size(); i++) {
+        const Edge& edge = result.edges[i];
+        Napi::Object e = Napi::Object::New(env);
+        e.Set("from", Napi::Number::New(env, edge.from));
+        e.Set("to", Napi::Number::New(env, edge.to));
+        e.Set("index", Napi::Number::New(env, edge.index));
+        e.Set("re", Napi::Number::New(env, edge.re));
+        e.Set("im", Napi::Number::New(env, edge.im));
+        edges.Set(i, e);
+    }
+
+    Napi::Object root = Napi::Object::New(env);
+    root.Set("id", Napi::Number::New(env, result.root));
+    root.Set("re", Napi::Number::New(env, result.rootRe));
+    root.Set("im", Napi::Number::New(env, result.rootIm));
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("root", root);
+    obj.Set("nodes", nodes);
+    obj.Set("edges", edges);
+    return obj;
+}
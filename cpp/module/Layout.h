@@ -0,0 +1,71 @@
+#ifndef QDD_VIS_LAYOUT_H
+#define QDD_VIS_LAYOUT_H
+
+#include <napi.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Computes a layered layout of a DD, so the client only has to draw it instead of running Graphviz on the .dot-output.
+ * Every level (qubit) is a layer with the terminal below the lowest one. The order within the layers is found with
+ * barycenter sweeps (alternately towards the terminal and towards the root) and the x-coordinates are the mean of a
+ * left- and a right-aligned placement of the barycenters that keeps at least NODE_SPACING between neighbours.
+ * Nodes that were part of the previous layout keep their id and use their previous x-coordinate as barycenter, so they
+ * only move if new nodes need the space. The previous root is ref-counted meanwhile, so its nodes can't be collected
+ * and their pointers can't be reused for different nodes.
+ */
+class Layout {
+public:
+    static constexpr double NODE_SPACING = 60;
+    static constexpr double LAYER_SPACING = 80;
+    static constexpr unsigned int SWEEPS = 4;
+
+    struct Node {
+        std::uint32_t id;   //0 for the terminal
+        short level;        //-1 for the terminal
+        double x, y;
+    };
+
+    struct Edge {
+        std::uint32_t from, to;     //ids of the nodes
+        unsigned short index;       //which edge of from it is
+        fp re, im;
+    };
+
+    struct Result {
+        std::vector<Node> nodes{};  //ordered by layer and x-coordinate
+        std::vector<Edge> edges{};  //edges with weight 0 are left out
+        std::uint32_t root = 0;     //id of the node the root edge points to
+        fp rootRe = 0, rootIm = 0;
+    };
+
+    Result layout(dd::Package& dd, const dd::Edge& root, bool isVector);
+    void clear(dd::Package& dd);
+    static Napi::Value toObject(Napi::Env env, const Result& result);
+
+private:
+    struct Vertex {
+        dd::NodePtr p;
+        std::uint32_t id;
+        int layer;
+        bool anchored;          //whether it was part of the previous layout
+        double x, key;
+        std::vector<std::pair<int, unsigned short>> parents{};   //index of the parent and of its edge
+        std::vector<std::pair<int, unsigned short>> children{};  //index of the child and of the edge
+    };
+
+    int collect(dd::NodePtr p, std::vector<Vertex>& vertices);
+    void place(std::vector<Vertex>& vertices, std::vector<int>& layer) const;
+    double portOffset(unsigned short index) const;
+
+    dd::Edge laidOut{};     //root of the previous layout, nullptr if there is none
+    std::uint32_t nextId = 1;
+    unsigned int arity = 2;
+    std::unordered_map<dd::NodePtr, std::pair<std::uint32_t, double>> previous{};  //id and x of the previous layout
+    std::unordered_map<dd::NodePtr, int> visited{};     //scratch: index in vertices
+};
+
+#endif //QDD_VIS_LAYOUT_H
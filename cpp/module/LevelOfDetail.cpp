@@ -0,0 +1,262 @@
+
+#include <algorithm>
+#include <queue>
+
+#include "LevelOfDetail.h"
+
+/**
+ *
+ * @param dd the package root belongs to
+ * @param root the DD to export
+ * @param isVector whether root is a vector DD (only e[0] and e[2] of its nodes are exported) or a matrix DD
+ * @param budget how many nodes are expanded at most (not counting the ones in expand)
+ * @param expand ids of summary nodes of a previous result for the same state that should be expanded
+ * @return the expanded nodes, the summary nodes below them and the edges of the expanded nodes
+ */
+LevelOfDetail::Result LevelOfDetail::build(dd::Package& dd, const dd::Edge& root, bool isVector, unsigned int budget,
+                                           const std::vector<std::uint32_t>& expand) {
+    if(analyzed.p == nullptr || !dd::Package::equals(analyzed, root) || arity != (isVector ? 2u : 4u)) {
+        clear(dd);
+        arity = isVector ? 2 : 4;
+        analyzed = root;
+        dd.incRef(analyzed);
+    }
+
+    Result result;
+    result.rootRe = CN::val(root.w.r);
+    result.rootIm = CN::val(root.w.i);
+    const bool empty = CN::equalsZero(root.w) || dd::Package::isTerminal(root);
+    if(empty) {
+        result.nodes.push_back(Node{0, -1, false, 0, CN::equalsZero(root.w) ? 0.0 : 1.0});
+        return result;
+    }
+    result.root = idOf(root.p);
+
+    //up is the sum of the squared weights of all paths from the root to a node that only pass expanded nodes, so it
+    //grows while the export is built (a node is queued again whenever it does)
+    std::unordered_map<dd::NodePtr, fp> up;
+    up[root.p] = CN::mag2(root.w);
+    const fp total = up[root.p] * squaredNorm(root.p);
+    auto mass = [&](dd::NodePtr p) { return total > 0 ? std::min<fp>(1, up[p] * squaredNorm(p) / total) : 0; };
+    std::unordered_set<dd::NodePtr> expanded;
+    std::unordered_set<dd::NodePtr> frontier;   //reachable from an expanded node (or the root)
+    frontier.insert(root.p);
+    auto expandNode = [&](dd::NodePtr p, std::priority_queue<std::pair<fp, dd::NodePtr>>* queue) {
+        expanded.insert(p);
+        for(unsigned short i = 0; i < arity; i++) {
+            const dd::Edge& e = edge(p, i);
+            if(CN::equalsZero(e.w) || dd::Package::isTerminal(e)) continue;
+            up[e.p] += up[p] * CN::mag2(e.w);
+            if(frontier.insert(e.p).second) idOf(e.p);
+            if(queue != nullptr && expanded.count(e.p) == 0) queue->emplace(mass(e.p), e.p);
+        }
+    };
+
+    std::priority_queue<std::pair<fp, dd::NodePtr>> queue;
+    queue.emplace(mass(root.p), root.p);
+    for(unsigned int n = 0; n < budget && !queue.empty(); ) {
+        dd::NodePtr p = queue.top().second;
+        queue.pop();
+        if(expanded.count(p) > 0) continue;
+        expandNode(p, &queue);
+        n++;
+    }
+
+    //requested nodes can only be expanded once they are visible, which may depend on other requested nodes
+    std::vector<dd::NodePtr> requested;
+    for(std::uint32_t id : expand) {
+        auto it = byId.find(id);
+        if(it != byId.end()) requested.push_back(it->second);
+    }
+    for(bool changed = true; changed; ) {
+        changed = false;
+        for(dd::NodePtr p : requested) {
+            if(expanded.count(p) == 0 && frontier.count(p) > 0) {
+                expandNode(p, nullptr);
+                changed = true;
+            }
+        }
+    }
+
+    //nodes in the order of their ids, so hidden nodes are always assigned to the same summary node
+    std::vector<dd::NodePtr> visible(frontier.begin(), frontier.end());
+    std::sort(visible.begin(), visible.end(), [this](dd::NodePtr a, dd::NodePtr b) { return ids[a] < ids[b]; });
+    bool terminalReached = false;
+    counted.clear();
+    counted.insert(visible.begin(), visible.end());     //visible nodes are never hidden
+    for(dd::NodePtr p : visible) {
+        const bool summary = expanded.count(p) == 0;
+        unsigned int hidden = 0;
+        for(unsigned short i = 0; summary && i < arity; i++) {
+            const dd::Edge& e = edge(p, i);
+            if(!CN::equalsZero(e.w) && !dd::Package::isTerminal(e)) countHidden(e.p, hidden);
+        }
+        result.nodes.push_back(Node{ids[p], p->v, summary, hidden, mass(p)});
+        if(summary) continue;
+
+        for(unsigned short i = 0; i < arity; i++) {
+            const dd::Edge& e = edge(p, i);
+            if(CN::equalsZero(e.w)) continue;
+            const bool terminal = dd::Package::isTerminal(e);
+            terminalReached |= terminal;
+            result.edges.push_back(Edge{ids[p], terminal ? 0 : ids[e.p], i, CN::val(e.w.r), CN::val(e.w.i)});
+        }
+    }
+    counted.clear();
+    if(terminalReached) result.nodes.push_back(Node{0, -1, false, 0, 1});
+    return result;
+}
+
+/**Forgets the analyzed state, e.g. before the package is reset.
+ *
+ * @param dd the package the analyzed state belongs to
+ */
+void LevelOfDetail::clear(dd::Package& dd) {
+    if(analyzed.p != nullptr) dd.decRef(analyzed);
+    analyzed = dd::Edge{};
+    ids.clear();
+    byId.clear();
+    norms.clear();
+}
+
+/**
+ *
+ * @param p a non-terminal node of the analyzed state
+ * @return the id of p, a new one if p wasn't visible in an export of this state before
+ */
+std::uint32_t LevelOfDetail::idOf(dd::NodePtr p) {
+    const auto id = (std::uint32_t)(ids.size() + 1);
+    auto inserted = ids.emplace(p, id);
+    if(inserted.second) byId.emplace(id, p);
+    return inserted.first->second;
+}
+
+/**Computes the squared norm below p, but only looks at MAX_NORM_NODES nodes whose norm isn't known yet, so it never
+ * traverses a big DD as a whole. Sub-DDs beyond that count as normalized (squared norm 1).
+ *
+ * @param p a non-terminal node of the analyzed state
+ * @return squared norm of the sub-DD p represents (without the weight of the edge pointing to p), exact for small
+ *          sub-DDs and estimated otherwise
+ */
+fp LevelOfDetail::squaredNorm(dd::NodePtr p) {
+    unsigned int budget = MAX_NORM_NODES;
+    return squaredNorm(p, budget);
+}
+
+/**
+ *
+ * @param p a non-terminal node of the analyzed state
+ * @param budget how many more nodes may be looked at, decreased by the number of nodes looked at
+ * @return see squaredNorm(p), 1 if the budget is used up and the norm of p isn't known yet
+ */
+fp LevelOfDetail::squaredNorm(dd::NodePtr p, unsigned int& budget) {
+    auto it = norms.find(p);
+    if(it != norms.end()) return it->second;
+    if(budget == 0) return 1;   //not memoized, so p gets its own budget once it is queued or visible
+    budget--;
+    fp norm = 0;
+    for(unsigned short i = 0; i < arity; i++) {
+        const dd::Edge& e = edge(p, i);
+        if(CN::equalsZero(e.w)) continue;
+        norm += CN::mag2(e.w) * (dd::Package::isTerminal(e) ? 1 : squaredNorm(e.p, budget));
+    }
+    norms.emplace(p, norm);
+    return norm;
+}
+
+/**Counts the nodes that are reachable from p (including p itself) and aren't counted yet, but stops once count
+ * reaches MAX_HIDDEN.
+ *
+ * @param p a node below a summary node
+ * @param count is increased by the number of found nodes
+ */
+void LevelOfDetail::countHidden(dd::NodePtr p, unsigned int& count) {
+    if(count >= MAX_HIDDEN || !counted.insert(p).second) return;
+    count++;
+    for(unsigned short i = 0; i < arity; i++) {
+        const dd::Edge& e = edge(p, i);
+        if(!CN::equalsZero(e.w) && !dd::Package::isTerminal(e)) countHidden(e.p, count);
+    }
+}
+
+/**Reads the options of a level-of-detail export and throws a JS exception if they are invalid.
+ *
+ * @param info has an optional object argument {budget: number of nodes to expand, expand: [ids of summary nodes]}
+ * @param budget is set to the given budget or DEFAULT_BUDGET
+ * @param expand is set to the given ids
+ * @return false if the options are invalid
+ */
+bool LevelOfDetail::parseOptions(const Napi::CallbackInfo& info, unsigned int& budget, std::vector<std::uint32_t>& expand) {
+    Napi::Env env = info.Env();
+    budget = DEFAULT_BUDGET;
+    expand.clear();
+    if(info.Length() == 0 || info[0].IsUndefined()) return true;
+    if(!info[0].IsObject()) {
+        Napi::TypeError::New(env, "Options must be an object!").ThrowAsJavaScriptException();
+        return false;
+    }
+
+    Napi::Object options = info[0].As<Napi::Object>();
+    if(options.Has("budget")) {
+        if(!options.Get("budget").IsNumber() || options.Get("budget").As<Napi::Number>().Int64Value() < 1) {
+            Napi::TypeError::New(env, "budget must be a positive number!").ThrowAsJavaScriptException();
+            return false;
+        }
+        budget = (unsigned int)options.Get("budget").As<Napi::Number>().Int64Value();
+    }
+    if(options.Has("expand")) {
+        if(!options.Get("expand").IsArray()) {
+            Napi::TypeError::New(env, "expand must be an array of node ids!").ThrowAsJavaScriptException();
+            return false;
+        }
+        Napi::Array ids = options.Get("expand").As<Napi::Array>();
+        for(std::uint32_t i = 0; i < ids.Length(); i++) {
+            Napi::Value id = ids.Get(i);
+            if(id.IsNumber()) expand.push_back(id.As<Napi::Number>().Uint32Value());
+        }
+    }
+    return true;
+}
+
+/**
+ *
+ * @param env the environment to create the object in
+ * @param result a level-of-detail export
+ * @return {root: {id, re, im}, nodes: [{id, level, summary, hidden, probability}], edges: [{from, to, index, re, im}]}
+ */
+Napi::Value LevelOfDetail::toObject(Napi::Env env, const Result& result) {
+    Napi::Array nodes = Napi::Array::New(env, result.nodes.size());
+    for(std::size_t i = 0; i < result.nodes.size(); i++) {
+        const Node& node = result.nodes[i];
+        Napi::Object n = Napi::Object::New(env);
+        n.Set("id", Napi::Number::New(env, node.id));
+        n.Set("level", Napi::Number::New(env, node.level));
+        n.Set("summary", Napi::Boolean::New(env, node.summary));
+        if(node.summary) n.Set("hidden", Napi::Number::New(env, node.hidden));
+        n.Set("probability", Napi::Number::New(env, node.probability));
+        nodes.Set(i, n);
+    }
+
+    Napi::Array edges = Napi::Array::New(env, result.edges.size());
+    for(std::size_t i = 0; i < result.edges.size(); i++) {
+        const Edge& edge = result.edges[i];
+        Napi::Object e = Napi::Object::New(env);
+        e.Set("from", Napi::Number::New(env, edge.from));
+        e.Set("to", Napi::Number::New(env, edge.to));
+        e.Set("index", Napi::Number::New(env, edge.index));
+        e.Set("re", Napi::Number::New(env, edge.re));
+        e.Set("im", Napi::Number::New(env, edge.im));
+        edges.Set(i, e);
+    }
+
+    Napi::Object root = Napi::Object::New(env);
+    root.Set("id", Napi::Number::New(env, result.root));
+    root.Set("re", Napi::Number::New(env, result.rootRe));
+    root.Set("im", Napi::Number::New(env, result.rootIm));
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("root", root);
+    obj.Set("nodes", nodes);
+    obj.Set("edges", edges);
+    return obj;
+}
@@ -0,0 +1,74 @@
+#ifndef QDD_VIS_LEVELOFDETAIL_H
+#define QDD_VIS_LEVELOFDETAIL_H
+
+#include <napi.h>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Exports a DD with at most a given number of expanded nodes, so big DDs can still be sent and rendered. Starting at
+ * the root, the nodes carrying the most probability (the squared norm of all paths through them) are expanded first.
+ * Once the budget is used up, the nodes that are reachable from expanded ones but not expanded themselves become
+ * summary nodes that carry their probability and how many nodes are hidden behind them. The client can ask to expand
+ * summary nodes, which is done in addition to the budget.
+ * Nothing is computed for the whole DD up front: node ids are given out when a node becomes visible, the squared norms
+ * below nodes are only computed for queued and visible nodes and look at most MAX_NORM_NODES new nodes deep (below that
+ * a sub-DD counts as normalized, so probabilities of big DDs are estimates), and hidden nodes are only counted up to
+ * MAX_HIDDEN per summary node. Ids and norms are kept for the state (the root is ref-counted meanwhile), so expanding
+ * summary nodes of the same state reuses them.
+ */
+class LevelOfDetail {
+public:
+    static constexpr unsigned int DEFAULT_BUDGET = 256;
+    static constexpr unsigned int MAX_HIDDEN = 1024;    //hidden nodes are counted up to this number per summary node
+    static constexpr unsigned int MAX_NORM_NODES = 1024;    //new nodes looked at per squared norm
+
+    struct Node {
+        std::uint32_t id;   //0 for the terminal
+        short level;        //-1 for the terminal
+        bool summary;       //whether it stands for the node and all hidden nodes below it
+        unsigned int hidden;    //number of nodes hidden behind a summary node (each hidden node is only counted once),
+                                //MAX_HIDDEN means at least that many
+        fp probability;     //share of the squared norm of all paths through this node that only pass expanded nodes
+                            //(estimated, see squaredNorm)
+    };
+
+    struct Edge {
+        std::uint32_t from, to;
+        unsigned short index;
+        fp re, im;
+    };
+
+    struct Result {
+        std::vector<Node> nodes{};
+        std::vector<Edge> edges{};  //only the edges of expanded nodes, edges with weight 0 are left out
+        std::uint32_t root = 0;
+        fp rootRe = 0, rootIm = 0;
+    };
+
+    Result build(dd::Package& dd, const dd::Edge& root, bool isVector, unsigned int budget,
+                 const std::vector<std::uint32_t>& expand);
+    void clear(dd::Package& dd);
+    static bool parseOptions(const Napi::CallbackInfo& info, unsigned int& budget, std::vector<std::uint32_t>& expand);
+    static Napi::Value toObject(Napi::Env env, const Result& result);
+
+private:
+    std::uint32_t idOf(dd::NodePtr p);
+    fp squaredNorm(dd::NodePtr p);
+    fp squaredNorm(dd::NodePtr p, unsigned int& budget);
+    void countHidden(dd::NodePtr p, unsigned int& count);
+    const dd::Edge& edge(dd::NodePtr p, unsigned short index) const { return p->e[arity == 2 ? 2 * index : index]; }
+
+    dd::Edge analyzed{};    //the state info belongs to, nullptr if there is none
+    unsigned int arity = 2;
+    std::unordered_map<dd::NodePtr, std::uint32_t> ids{};  //of the nodes that were visible in an export of the state
+    std::unordered_map<std::uint32_t, dd::NodePtr> byId{};
+    std::unordered_map<dd::NodePtr, fp> norms{};            //(estimated) squared norms of the sub-DDs computed so far
+    std::unordered_set<dd::NodePtr> counted{};  //scratch: visible nodes and hidden nodes already assigned to a summary
+};
+
+#endif //QDD_VIS_LEVELOFDETAIL_H
@@ -0,0 +1,94 @@
+
+#include "Marginals.h"
+
+/**
+ *
+ * @param dd the package the state belongs to
+ * @param state a vector DD
+ * @return (P(0), P(1)) for every qubit (indexed by qubit), computed only if state differs from the previous call
+ */
+const std::vector<std::pair<fp, fp>>& Marginals::get(dd::Package& dd, const dd::Edge& state) {
+    if(cached.p != nullptr && dd::Package::equals(cached, state)) return probabilities;
+
+    clear(dd);
+    compute(state);
+    cached = state;
+    dd.incRef(cached);
+    return probabilities;
+}
+
+/**Forgets the remembered state, e.g. before the package is reset.
+ *
+ * @param dd the package the remembered state belongs to
+ */
+void Marginals::clear(dd::Package& dd) {
+    if(cached.p != nullptr) dd.decRef(cached);
+    cached = dd::Edge{};
+    probabilities.clear();
+}
+
+/**Collects all nodes, computes the squared norm below every node bottom-up and the probability of reaching every node
+ * top-down. The probability of measuring 0 (1) for a qubit is then the sum over all nodes of its level of upstream
+ * times the squared weight of the 0-edge (1-edge) times the squared norm of the node it points to.
+ *
+ * @param state a vector DD (only e[0] and e[2] of its nodes are used)
+ */
+void Marginals::compute(const dd::Edge& state) {
+    index.clear();
+    nodes.clear();
+    if(dd::Package::isTerminal(state)) return;
+
+    //collect all nodes, every edge points to a node with a smaller level
+    indexOf(state.p);
+    for(std::size_t i = 0; i < nodes.size(); i++) {
+        for(int e = 0; e <= 2; e += 2) {
+            const dd::Edge& child = nodes[i]->e[e];
+            if(!CN::equalsZero(child.w) && !dd::Package::isTerminal(child)) indexOf(child.p);
+        }
+    }
+    //highest level first, so every node comes after all of its parents (counting sort by level)
+    const unsigned int levels = state.p->v + 1;
+    std::vector<unsigned int> start(levels + 1, 0);
+    for(const dd::NodePtr node : nodes) ++start[levels - node->v];
+    for(unsigned int l = 1; l <= levels; l++) start[l] += start[l - 1];
+    std::vector<unsigned int> order(nodes.size());
+    for(unsigned int i = 0; i < nodes.size(); i++) order[start[levels - 1 - nodes[i]->v]++] = i;
+
+    upstream.assign(nodes.size(), 0);
+    downstream.assign(nodes.size(), 0);
+    probabilities.assign(levels, {0, 0});
+
+    auto norm = [this](const dd::Edge& edge) -> fp {
+        if(CN::equalsZero(edge.w)) return 0;
+        const fp below = dd::Package::isTerminal(edge) ? 1 : downstream[index[edge.p]];
+        return CN::mag2(edge.w) * below;
+    };
+
+    for(auto it = order.rbegin(); it != order.rend(); ++it) {
+        const dd::NodePtr node = nodes[*it];
+        downstream[*it] = norm(node->e[0]) + norm(node->e[2]);
+    }
+
+    upstream[index[state.p]] = CN::mag2(state.w);
+    for(const unsigned int i : order) {
+        const dd::NodePtr node = nodes[i];
+        probabilities[node->v].first += upstream[i] * norm(node->e[0]);
+        probabilities[node->v].second += upstream[i] * norm(node->e[2]);
+
+        for(int e = 0; e <= 2; e += 2) {
+            const dd::Edge& child = node->e[e];
+            if(CN::equalsZero(child.w) || dd::Package::isTerminal(child)) continue;
+            upstream[index[child.p]] += upstream[i] * CN::mag2(child.w);
+        }
+    }
+}
+
+unsigned int Marginals::indexOf(dd::NodePtr node) {
+    auto it = index.find(node);
+    if(it != index.end()) return it->second;
+
+    const auto i = (unsigned int)nodes.size();
+    index.emplace(node, i);
+    nodes.push_back(node);
+    return i;
+}
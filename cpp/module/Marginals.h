@@ -0,0 +1,35 @@
+#ifndef QDD_VIS_MARGINALS_H
+#define QDD_VIS_MARGINALS_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Computes the probabilities of measuring 0 or 1 for every qubit of a vector DD in one pass over its nodes and keeps
+ * the result for the last state it was asked for. The state is ref-counted while it is remembered, so its nodes can't
+ * be collected and reused for another state with the same pointer.
+ * The scratch arrays are kept between calls, so repeated computations don't allocate again.
+ */
+class Marginals {
+public:
+    const std::vector<std::pair<fp, fp>>& get(dd::Package& dd, const dd::Edge& state);
+    void clear(dd::Package& dd);
+
+private:
+    void compute(const dd::Edge& state);
+    unsigned int indexOf(dd::NodePtr node);
+
+    dd::Edge cached{};      //the state the probabilities belong to, nullptr if there is none
+    std::vector<std::pair<fp, fp>> probabilities{};     //(P(0), P(1)) per qubit
+
+    //scratch space, indexed by the position of the node in nodes
+    std::unordered_map<dd::NodePtr, unsigned int> index{};
+    std::vector<dd::NodePtr> nodes{};
+    std::vector<fp> upstream{};     //probability of reaching the node from the root
+    std::vector<fp> downstream{};   //squared norm of the sub-vector the node represents
+};
+
+#endif //QDD_VIS_MARGINALS_H
@@ -0,0 +1,49 @@
+
+#include "MemoryUsage.h"
+
+/**
+ *
+ * @param dd the package of the session, nullptr if it currently has none
+ * @param cacheBytes size of everything the session keeps outside of the package
+ * @return the estimated memory usage of the session
+ */
+MemoryUsage MemoryUsage::of(const dd::Package* dd, std::size_t cacheBytes) {
+    MemoryUsage usage{};
+    usage.cacheBytes = cacheBytes;
+    if(dd != nullptr) {
+        usage.hasPackage = true;
+        usage.nodes = dd->nodecount;
+        usage.activeNodes = dd->activeNodeCount;
+        usage.peakNodes = dd->peaknodecount;
+        usage.complexEntries = dd->cn.count;
+        usage.tableBytes = sizeof(dd::Package);
+        usage.nodeBytes = usage.nodes * sizeof(dd::Node);
+        usage.complexBytes = usage.complexEntries * sizeof(dd::ComplexTableEntry);
+    }
+    usage.bytes = usage.tableBytes + usage.nodeBytes + usage.complexBytes + usage.cacheBytes;
+    return usage;
+}
+
+/**
+ *
+ * @param env the environment the object is created in
+ * @return object with members
+ *          hasPackage: whether the session currently holds a dd::Package
+ *          nodes, activeNodes, peakNodes, complexEntries: counts of the package (0 without a package)
+ *          tableBytes, nodeBytes, complexBytes, cacheBytes: estimated size of the different parts in bytes
+ *          bytes: estimated size of everything together
+ */
+Napi::Object MemoryUsage::toObject(Napi::Env env) const {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("hasPackage", Napi::Boolean::New(env, hasPackage));
+    obj.Set("nodes", Napi::Number::New(env, nodes));
+    obj.Set("activeNodes", Napi::Number::New(env, activeNodes));
+    obj.Set("peakNodes", Napi::Number::New(env, peakNodes));
+    obj.Set("complexEntries", Napi::Number::New(env, complexEntries));
+    obj.Set("tableBytes", Napi::Number::New(env, tableBytes));
+    obj.Set("nodeBytes", Napi::Number::New(env, nodeBytes));
+    obj.Set("complexBytes", Napi::Number::New(env, complexBytes));
+    obj.Set("cacheBytes", Napi::Number::New(env, cacheBytes));
+    obj.Set("bytes", Napi::Number::New(env, bytes));
+    return obj;
+}
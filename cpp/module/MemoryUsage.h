@@ -0,0 +1,30 @@
+#ifndef QDD_VIS_MEMORYUSAGE_H
+#define QDD_VIS_MEMORYUSAGE_H
+
+#include <napi.h>
+#include <cstddef>
+
+#include "DDpackage.h"
+
+/**Estimate of the native memory a session holds, so the server can compare sessions and evict or compact the heavy
+ * ones first. The tables of a package are counted with their fixed size, nodes and complex table entries with the
+ * number that is currently in the tables. The package keeps freed nodes for reuse, so the memory it actually occupies
+ * can be closer to peakNodes.
+ */
+struct MemoryUsage {
+    bool hasPackage = false;
+    unsigned long nodes = 0;            //nodes in the unique table
+    unsigned long activeNodes = 0;      //nodes that are referenced by at least one DD
+    unsigned long peakNodes = 0;        //most nodes the package ever held (also before this session acquired it)
+    unsigned long complexEntries = 0;   //entries in the complex table
+    std::size_t tableBytes = 0;         //fixed size of the package (unique-, compute- and complex-tables)
+    std::size_t nodeBytes = 0;
+    std::size_t complexBytes = 0;
+    std::size_t cacheBytes = 0;         //copies of DDs the session keeps outside of the package (e.g. exports)
+    std::size_t bytes = 0;              //sum of all of the above
+
+    static MemoryUsage of(const dd::Package* dd, std::size_t cacheBytes);
+    Napi::Object toObject(Napi::Env env) const;
+};
+
+#endif //QDD_VIS_MEMORYUSAGE_H
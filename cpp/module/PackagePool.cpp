@@ -0,0 +1,57 @@
+
+#include "PackagePool.h"
+
+std::mutex PackagePool::mutex{};
+std::vector<std::unique_ptr<dd::Package>> PackagePool::packages{};
+
+/**
+ *
+ * @param mode whether the package is used for vectors or matrices
+ * @return an idle package or a new one if there is none
+ */
+std::unique_ptr<dd::Package> PackagePool::acquire(dd::Mode mode) {
+    std::unique_ptr<dd::Package> package;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!packages.empty()) {
+            package = std::move(packages.back());
+            packages.pop_back();
+        }
+    }
+    if(!package) package = std::make_unique<dd::Package>();
+    package->setMode(mode);
+    return package;
+}
+
+/**Takes back a package that is no longer needed. The caller must have dereferenced all of its DDs.
+ *
+ * @param package the package to release, may be nullptr
+ */
+void PackagePool::release(std::unique_ptr<dd::Package> package) {
+    if(!package) return;
+    package->garbageCollect(true);  //frees all nodes and complex numbers, since nothing is referenced anymore
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(packages.size() < MAX_IDLE) packages.push_back(std::move(package));
+}   //otherwise the package is destroyed here
+
+/**Creates packages until there are at least count idle ones, so the first loads don't have to allocate them.
+ *
+ * @param count number of idle packages to have
+ */
+void PackagePool::warmUp(std::size_t count) {
+    while(idle() < count) {
+        auto package = std::make_unique<dd::Package>();
+        std::lock_guard<std::mutex> lock(mutex);
+        packages.push_back(std::move(package));
+    }
+}
+
+/**
+ *
+ * @return number of packages waiting to be acquired
+ */
+std::size_t PackagePool::idle() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return packages.size();
+}
@@ -0,0 +1,31 @@
+#ifndef QDD_VIS_PACKAGEPOOL_H
+#define QDD_VIS_PACKAGEPOOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "DDpackage.h"
+
+/**Process-wide pool of dd::Packages, so sessions only hold the big unique-, compute- and complex-tables of a package
+ * while they actually have an algorithm loaded. A session acquires a package on its first load and releases it when
+ * it is cleaned up or unreadied. Released packages have to be free of references; they are garbage collected
+ * (forced) and kept for the next session as long as there are less than MAX_IDLE idle ones.
+ * All functions are thread-safe, since packages are acquired by loads running on worker threads.
+ */
+class PackagePool {
+public:
+    static constexpr std::size_t MAX_IDLE = 4;          //more released packages are destroyed
+    static constexpr std::size_t WARM_PACKAGES = 1;     //how many packages are created when the module is loaded
+
+    static std::unique_ptr<dd::Package> acquire(dd::Mode mode);
+    static void release(std::unique_ptr<dd::Package> package);
+    static void warmUp(std::size_t count);
+    static std::size_t idle();
+
+private:
+    static std::mutex mutex;
+    static std::vector<std::unique_ptr<dd::Package>> packages;  //idle packages
+};
+
+#endif //QDD_VIS_PACKAGEPOOL_H
@@ -0,0 +1,72 @@
+
+#include "Progress.h"
+
+/**Must be created on the main thread since it reads the options and creates the thread-safe function.
+ *
+ * @param env the environment of the call
+ * @param options either an object with the optional members progress and timeout or any other value (no options)
+ * @param cancelRequests counter of the owner that its cancel()-method increments; only requests that arrive after this
+ *          call was submitted (while it is queued or running) cancel it
+ */
+Progress::Progress(Napi::Env env, const Napi::Value& options, const std::atomic<unsigned int>& cancelRequests)
+        : cancelRequests(cancelRequests), cancelRequestsAtStart(cancelRequests), start(std::chrono::steady_clock::now()),
+          lastReport(start) {
+    if(!options.IsObject()) return;
+
+    const Napi::Object obj = options.As<Napi::Object>();
+    if(obj.Has("timeout") && obj.Get("timeout").IsNumber()) {
+        timeout = obj.Get("timeout").As<Napi::Number>().Int64Value();
+    }
+    if(obj.Has("progress") && obj.Get("progress").IsFunction()) {
+        callback = Napi::ThreadSafeFunction::New(env, obj.Get("progress").As<Napi::Function>(), "QDDVisProgress", 0, 1);
+        hasCallback = true;
+    }
+}
+
+Progress::~Progress() {
+    if(hasCallback) callback.Release();
+}
+
+/**Has to be called after every processed operation. Reports a progress event at most every REPORT_INTERVAL ms.
+ *
+ * @param position the current position of the iterator
+ * @param dd the package of the state
+ * @param state the current state (only traversed when an event is reported)
+ * @return true if the caller should stop because the call was cancelled or the deadline was exceeded
+ */
+bool Progress::step(unsigned int position, dd::Package& dd, const dd::Edge& state) {
+    ++ops;
+    const auto now = std::chrono::steady_clock::now();
+    if(hasCallback && std::chrono::duration_cast<std::chrono::milliseconds>(now - lastReport).count() >= REPORT_INTERVAL) {
+        lastReport = now;
+        auto event = new Event{ops, position, dd.size(state), elapsed()};
+        const auto status = callback.NonBlockingCall(event, [](Napi::Env env, Napi::Function jsCallback, Event* event) {
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("ops", Napi::Number::New(env, event->ops));
+            obj.Set("position", Napi::Number::New(env, event->position));
+            obj.Set("nodes", Napi::Number::New(env, event->nodes));
+            obj.Set("elapsed", Napi::Number::New(env, event->elapsed));
+            jsCallback.Call({obj});
+            delete event;
+        });
+        if(status != napi_ok) delete event;     //the queue is closed, so the event is never delivered
+    }
+
+    return shouldStop();
+}
+
+/**Can be called from any thread, e.g. by work that is split with Scheduler::parallelFor.
+ *
+ * @return true if the call was cancelled or the deadline was exceeded
+ */
+bool Progress::shouldStop() const {
+    return cancelRequests != cancelRequestsAtStart || (timeout > 0 && elapsed() >= timeout);
+}
+
+/**
+ *
+ * @return ms since the call started
+ */
+long long Progress::elapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
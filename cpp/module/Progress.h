@@ -0,0 +1,49 @@
+#ifndef QDD_VIS_PROGRESS_H
+#define QDD_VIS_PROGRESS_H
+
+#include <napi.h>
+#include <atomic>
+#include <chrono>
+
+#include "DDpackage.h"
+
+/**Accompanies a long-running asynchronous call: reports periodic progress events to an optional JS callback (via a
+ * Napi::ThreadSafeFunction) and tells the stepping loops when to stop because the call was cancelled or its deadline
+ * has been exceeded. The loops only stop between two operations, so the state always lands on the last completed one.
+ *
+ * Options (all optional): { progress: function({ops, position, nodes, elapsed}), timeout: ms }
+ */
+class Progress {
+public:
+    static constexpr long long REPORT_INTERVAL = 100;    //ms between two progress events
+
+    Progress(Napi::Env env, const Napi::Value& options, const std::atomic<unsigned int>& cancelRequests);
+    ~Progress();
+    Progress(const Progress&) = delete;
+    Progress& operator=(const Progress&) = delete;
+
+    bool step(unsigned int position, dd::Package& dd, const dd::Edge& state);
+    bool shouldStop() const;
+    unsigned long long getOps() const { return ops; }
+
+private:
+    struct Event {
+        unsigned long long ops;
+        unsigned int position;
+        unsigned int nodes;
+        long long elapsed;
+    };
+
+    long long elapsed() const;
+
+    const std::atomic<unsigned int>& cancelRequests;
+    const unsigned int cancelRequestsAtStart;  //the call is cancelled once cancelRequests differs from this
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point lastReport;
+    long long timeout = 0;  //in ms, 0 means no deadline
+    bool hasCallback = false;
+    Napi::ThreadSafeFunction callback;
+    unsigned long long ops = 0;     //number of operations processed so far
+};
+
+#endif //QDD_VIS_PROGRESS_H
@@ -6,6 +6,8 @@
 #include <iostream>
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <chrono>
 
 #include "operations/StandardOperation.hpp"
 #include "QuantumComputation.hpp"
@@ -14,6 +16,9 @@
 #include "DDpackage.h"
 
 #include "QDDVer.h"
+#include "CircuitDiff.h"
+#include "AsyncTask.h"
+#include "Scheduler.h"
 
 Napi::FunctionReference QDDVer::constructor;
 
@@ -34,7 +39,32 @@ Napi::Object QDDVer::Init(Napi::Env env, Napi::Object exports) {
                                   InstanceMethod("updateExportOptions", &QDDVer::UpdateExportOptions),
                                   InstanceMethod("getExportOptions", &QDDVer::GetExportOptions),
                                   InstanceMethod("isReady", &QDDVer::IsReady),
-                                  InstanceMethod("unready", &QDDVer::Unready)
+                                  InstanceMethod("unready", &QDDVer::Unready),
+                                  InstanceMethod("loadAsync", &QDDVer::LoadAsync),
+                                  InstanceMethod("toStartAsync", &QDDVer::ToStartAsync),
+                                  InstanceMethod("prevAsync", &QDDVer::PrevAsync),
+                                  InstanceMethod("nextAsync", &QDDVer::NextAsync),
+                                  InstanceMethod("toEndAsync", &QDDVer::ToEndAsync),
+                                  InstanceMethod("toLineAsync", &QDDVer::ToLineAsync),
+                                  InstanceMethod("getDDAsync", &QDDVer::GetDDAsync),
+                                  InstanceMethod("getDDBinary", &QDDVer::GetDDBinary),
+                                  InstanceMethod("getDDBinaryAsync", &QDDVer::GetDDBinaryAsync),
+                                  InstanceMethod("getDDDiff", &QDDVer::GetDDDiff),
+                                  InstanceMethod("getDDDiffAsync", &QDDVer::GetDDDiffAsync),
+                                  InstanceMethod("getLayout", &QDDVer::GetLayout),
+                                  InstanceMethod("getLayoutAsync", &QDDVer::GetLayoutAsync),
+                                  InstanceMethod("getDDSummary", &QDDVer::GetDDSummary),
+                                  InstanceMethod("getDDSummaryAsync", &QDDVer::GetDDSummaryAsync),
+                                  InstanceMethod("cancel", &QDDVer::Cancel),
+                                  InstanceMethod("getStats", &QDDVer::GetStats),
+                                  InstanceMethod("setGCPolicy", &QDDVer::SetGCPolicy),
+                                  InstanceMethod("release", &QDDVer::Release),
+                                  InstanceMethod("memoryUsage", &QDDVer::GetMemoryUsage),
+                                  InstanceMethod("compact", &QDDVer::Compact),
+                                  InstanceMethod("checkEquivalence", &QDDVer::CheckEquivalence),
+                                  InstanceMethod("checkEquivalenceAsync", &QDDVer::CheckEquivalenceAsync),
+                                  InstanceMethod("findCounterexample", &QDDVer::FindCounterexample),
+                                  InstanceMethod("findCounterexampleAsync", &QDDVer::FindCounterexampleAsync)
                                   //InstanceMethod("conductIrreversibleOperation", &QDDVer::ConductIrreversibleOperation)
                           }
             );
@@ -56,15 +86,13 @@ QDDVer::QDDVer(const Napi::CallbackInfo& info) : Napi::ObjectWrap<QDDVer>(info)
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
-    this->dd = std::make_unique<dd::Package>();
-    this->dd->setMode(dd::Matrix);
-    this->line.fill(qc::LINE_DEFAULT);
+    this->line.fill(qc::LINE_DEFAULT);    //the package is only acquired on the first load
 
-    this->qc1 = std::make_unique<qc::QuantumComputation>();
+    this->qc1 = CircuitCache::empty();
     this->iterator1 = this->qc1->begin();
     this->position1 = 0;
 
-    this->qc2 = std::make_unique<qc::QuantumComputation>();
+    this->qc2 = CircuitCache::empty();
     this->iterator2 = this->qc2->begin();
     this->position2 = 0;
 
@@ -79,13 +107,13 @@ QDDVer::QDDVer(const Napi::CallbackInfo& info) : Napi::ObjectWrap<QDDVer>(info)
 void QDDVer::stepForward(bool algo1) {
     if(algo1) {
         if(atEnd1) return;   //no further steps possible
-        const dd::Edge currDD = (*iterator1)->getDD(dd, line, map1);    //retrieve the "new" current operation
+        const dd::Edge currDD = gateDD(true, false);    //retrieve the "new" current operation
 
         auto temp = dd->multiply(currDD, sim);         //process the current operation by multiplying it with the previous simulation-state
         dd->incRef(temp);
         dd->decRef(sim);
         sim = temp;
-        dd->garbageCollect();
+        gc.afterStep(*dd);
 
         iterator1++; // advance iterator
         position1++;
@@ -94,19 +122,45 @@ void QDDVer::stepForward(bool algo1) {
 
     } else {
         if(atEnd2) return;   //no further steps possible
-        const dd::Edge currDD = (*iterator2)->getInverseDD(dd, line, map2);    //retrieve the inverse of the "new" current operation
+        const dd::Edge currDD = gateDD(false, true);    //retrieve the inverse of the "new" current operation
 
         auto temp = dd->multiply(sim, currDD);         //process the current operation by multiplying it with the previous simulation-state
         dd->incRef(temp);
         dd->decRef(sim);
         sim = temp;
-        dd->garbageCollect();
+        gc.afterStep(*dd);
 
         iterator2++; // advance iterator
         position2++;
         //qc2->end() is after the last operation in the iterator
         if (iterator2 == qc2->end()) atEnd2 = true;
     }
+    checkpoints.offer(*dd, {position1, position2}, sim, map1, map2);
+}
+
+/**Returns the DD of the operation the iterator of algo1 or algo2 is pointing at, preferably from the gate cache.
+ * SWAPs (and compound operations that may contain them) always bypass the cache because retrieving their DD updates
+ * the permutation map.
+ *
+ * @param algo1 whether the operation belongs to algo1 or algo2
+ * @param inverse whether the inverse DD of the operation is needed
+ * @return the (inverse) DD of the current operation
+ */
+dd::Edge QDDVer::gateDD(bool algo1, bool inverse) {
+    auto& op = algo1 ? *iterator1 : *iterator2;
+    auto& map = algo1 ? map1 : map2;
+    if(op->getType() == qc::SWAP || op->getType() == qc::Compound) {
+        return inverse ? op->getInverseDD(dd, line, map) : op->getDD(dd, line, map);
+    }
+
+    GateCache& gates = algo1 ? gates1 : gates2;
+    const unsigned int position = algo1 ? position1 : position2;
+    dd::Edge gate{};
+    if(gates.lookup(position, inverse, gate)) return gate;
+
+    gate = inverse ? op->getInverseDD(dd, line, map) : op->getDD(dd, line, map);
+    gates.store(*dd, position, inverse, gate);
+    return gate;
 }
 
 /**If either atInitial is true or the iterator is at the beginning, this method does nothing. In other cases it will
@@ -128,13 +182,13 @@ void QDDVer::stepBack(bool algo1) {
         iterator1--; //set iterator back to the desired operation
         position1--;
 
-        const dd::Edge currDD = (*iterator1)->getInverseDD(dd, line, map1); // get the inverse of the current operation
+        const dd::Edge currDD = gateDD(true, true); // get the inverse of the current operation
 
         auto temp = dd->multiply(currDD, sim);   //"remove" the current operation by multiplying with its inverse
         dd->incRef(temp);
         dd->decRef(sim);
         sim = temp;
-        dd->garbageCollect();
+        gc.afterStep(*dd);
 
     } else {
         if(atInitial2) return;   //no step back possible
@@ -147,32 +201,98 @@ void QDDVer::stepBack(bool algo1) {
         iterator2--; //set iterator back to the desired operation
         position2--;
 
-        const dd::Edge currDD = (*iterator2)->getDD(dd, line, map2); // get the current operation
+        const dd::Edge currDD = gateDD(false, false); // get the current operation
 
         auto temp = dd->multiply(sim, currDD);   //"remove" the current operation by multiplying with its inverse
         dd->incRef(temp);
         dd->decRef(sim);
         sim = temp;
-        dd->garbageCollect();
+        gc.afterStep(*dd);
     }
 }
 
-/**Removes all applied operations by taking steps back until atInitial is true.
+/**Removes all applied operations of algo1 or algo2, starting from the nearest checkpoint instead of undoing them one
+ * at a time.
  * atInitial will be true and in most cases atEnd will be false (special case for empty algorithms: atEnd is also true)
  * after this call.
  *
  * @param algo1 decides whether the function should be applied to algo1 or algo2.
  */
 void QDDVer::stepToStart(bool algo1) {
-    if(algo1) {
-        //go one step back at a time until all operations have been reversed (atInitial is set to true in stepBack)
-        while(!atInitial1) stepBack(true);
-        //now atInitial is true, exactly as it should be
-    } else {
-        //go one step back at a time until all operations have been reversed (atInitial is set to true in stepBack)
-        while(!atInitial2) stepBack(false);
-        //now atInitial is true, exactly as it should be
+    StepResult result;
+    if(algo1)   moveTo(0, position2, result);
+    else        moveTo(position1, 0, result);
+    gc.endOfBatch(*dd);
+}
+
+/**Moves both iterators to the given positions. If a checkpoint is closer to the target than the current positions,
+ * it is restored first, so only the operations between the checkpoint and the target are applied or undone.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param target1 the position iterator1 should point at after this call (at most the number of operations of algo1)
+ * @param target2 the position iterator2 should point at after this call (at most the number of operations of algo2)
+ * @param result changed is set if the DD changed, cancelled if progress stopped the call
+ * @param progress if not nullptr, processing stops early when it says so (the state stays at the last applied operation)
+ */
+void QDDVer::moveTo(unsigned int target1, unsigned int target2, StepResult& result, Progress* progress) {
+    const CheckpointGrid::Position target{target1, target2};
+    const CheckpointGrid::Position current{position1, position2};
+    if(current == target) return;   //nothing changed
+    result.changed = true;
+
+    //an algorithm that isn't loaded keeps its position, its operations may not even be part of sim
+    CheckpointGrid::Position cpPos{};
+    const CheckpointGrid::Checkpoint* cp = checkpoints.nearest(target, cpPos, !ready1, !ready2);
+    if(cp != nullptr && CheckpointGrid::distance(cpPos, target) < CheckpointGrid::distance(current, target)) {
+        restoreCheckpoint(cpPos, *cp);
+    }
+
+    atInitial1 = false;
+    atEnd1 = false;
+    atInitial2 = false;
+    atEnd2 = false;
+    //only one of the two loops per algorithm can be entered
+    while(!result.cancelled && position1 > target1) {
+        stepBack(true);
+        if(progress != nullptr && progress->step(position1, *dd, sim)) result.cancelled = true;
+    }
+    while(!result.cancelled && position1 < target1) {
+        stepForward(true);
+        if(progress != nullptr && progress->step(position1, *dd, sim)) result.cancelled = true;
     }
+    while(!result.cancelled && position2 > target2) {
+        stepBack(false);
+        if(progress != nullptr && progress->step(position2, *dd, sim)) result.cancelled = true;
+    }
+    while(!result.cancelled && position2 < target2) {
+        stepForward(false);
+        if(progress != nullptr && progress->step(position2, *dd, sim)) result.cancelled = true;
+    }
+
+    atInitial1 = (position1 == 0);
+    atEnd1 = (position1 == qc1->getNops());
+    atInitial2 = (position2 == 0);
+    atEnd2 = (position2 == qc2->getNops());
+}
+
+/**Replaces sim by the state of the given checkpoint and moves both iterators to its position.
+ *
+ * @param position the position of the checkpoint
+ * @param cp the checkpoint to restore
+ */
+void QDDVer::restoreCheckpoint(const CheckpointGrid::Position& position, const CheckpointGrid::Checkpoint& cp) {
+    dd::Edge restored = cp.state;
+    dd->incRef(restored);
+    dd->decRef(sim);
+    sim = restored;
+
+    //at the start the permutation is the initial layout, which may have changed since the checkpoint was recorded
+    position1 = position.first;
+    iterator1 = qc1->begin() + position1;
+    map1 = position1 == 0 ? qc1->initialLayout : cp.map1;
+    position2 = position.second;
+    iterator2 = qc2->begin() + position2;
+    map2 = position2 == 0 ? qc2->initialLayout : cp.map2;
 }
 
 /*
@@ -266,128 +386,222 @@ void QDDVer::measureQubit(unsigned short qubitIdx, bool measureOne, fp pzero, fp
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/**Parameters: String algorithm, unsigned int formatCode, unsigned int num of operations to step forward, bool whether the
- * operations should be processed or just the iterator needs to be advanced, whether we load algo1 or algo2
- * Returns: true or false
+/**
  *
- * Tries to import the passed algorithm and returns whether it was successful or not. Additionally some operations/DDs can
- * be applied or just the iterator advance forward without applying operations/DDs.
+ * @param algo1 whether we want to know about algo1 or algo2
+ * @return true if the algorithm has been loaded, false otherwise
  */
-Napi::Value QDDVer::Load(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    Napi::Object state = Napi::Object::New(env);
-    state.Set("numOfOperations", Napi::Number::New(env, -1));
+bool QDDVer::isLoaded(bool algo1) const {
+    return algo1 ? ready1 : ready2;
+}
+
+/**Checks whether sim is the identity, which only takes a pointer comparison, and counts the nodes that still differ
+ * from it (incrementally, see Identity::track). Until both algorithms are at their end, a sim that isn't the identity
+ * is only NotYet instead of NotEquivalent.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param result is filled with verdict and nonIdentityNodes
+ */
+void QDDVer::inspect(StepResult& result) {
+    if(sim.p == nullptr) return;
+    result.verdict = identity.compare(sim);
+    const bool finished = ready1 && ready2 && position1 == qc1->getNops() && position2 == qc2->getNops();
+    if(result.verdict == Equivalence::Verdict::NotEquivalent && !finished) result.verdict = Equivalence::Verdict::NotYet;
+    result.nonIdentityNodes = identity.track(*dd, sim);
+}
+
+/**Adds the members verdict (name as in Equivalence::verdictName) and nonIdentityNodes of the given result to a state.
+ *
+ * @param env the environment the state was created in
+ * @param state the object returned by one of the step functions
+ * @param result a result filled by inspect
+ */
+void QDDVer::setInspection(Napi::Env env, Napi::Object& state, const StepResult& result) {
+    state.Set("verdict", Napi::String::New(env, Equivalence::verdictName(result.verdict)));
+    state.Set("nonIdentityNodes", Napi::Number::New(env, result.nonIdentityNodes));
+}
+
+/**
+ *
+ * @param circuit one of the algorithms
+ * @return the identity on the qubits of the algorithm, reduced by its ancillae (not ref-counted)
+ */
+dd::Edge QDDVer::initialMatrix(const CircuitCache::Circuit& circuit) {
+    //createInitialMatrix doesn't modify the computation, it just isn't declared const
+    return std::const_pointer_cast<qc::QuantumComputation>(circuit)->createInitialMatrix(dd);
+}
 
+/**Checks the parameters of Load and LoadAsync and throws an error if they are invalid.
+ *
+ * @param info the parameters of the call
+ * @return true if the parameters are valid, false otherwise
+ */
+bool QDDVer::checkLoadArguments(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
     //check if the correct parameters have been passed
     if(info.Length() < 5) {
         Napi::RangeError::New(env, "Need 5 (String, unsigned int, unsigned int, bool, bool) arguments!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[0].IsString()) {  //algorithm
         Napi::TypeError::New(env, "arg1: String expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[1].IsNumber()) {  //format code (1 = QASM, 2 = Real)
         Napi::TypeError::New(env, "arg3: unsigned int expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[2].IsNumber()) {  //number of operations to immediately process
         Napi::TypeError::New(env, "arg2: unsigned int expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[3].IsBoolean()) { //whether operations should be processed while advancing the iterator to opNum or not (true = new simulation; false = continue simulation)
         Napi::TypeError::New(env, "arg3: boolean expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[4].IsBoolean()) { //whether we load as algo1 (true) or algo2 (false)
         Napi::TypeError::New(env, "arg4: boolean expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
+    return true;
+}
 
-    //the first parameter (algorithm)
-    Napi::String arg = info[0].As<Napi::String>();
-    const std::string algo = arg.Utf8Value();
-    std::stringstream ss{algo};
-
-    //the third parameter (how many operations to apply immediately)
-    unsigned int opNum = (unsigned int)info[2].As<Napi::Number>();
-    //at this point opNum might be bigger than the number of operations the algorithm has!
-
-    //the fourth parameter tells us to process iterated operations or not
-    const bool process = (bool)info[3].As<Napi::Boolean>();
-
-    //the fifth parameter (algo1)
-    bool algo1 = (bool)info[4].As<Napi::Boolean>();
+/**Imports the given algorithm as algo1 or algo2 and applies opNum operations or just advances the iterator by opNum
+ * operations. If the new algorithm is an edited version of the loaded one, only the operations from the first edited
+ * one (or opNum, if it is smaller) on are undone and the remaining operations up to opNum are applied.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param algo the algorithm to import
+ * @param formatCode format of the algorithm (1 = QASM, 2 = Real)
+ * @param opNum number of operations to step forward (may be bigger than the number of operations of the algorithm)
+ * @param process whether the operations should be processed or just the iterator needs to be advanced
+ * @param algo1 whether we load algo1 or algo2
+ * @param result is filled with numOfOperations and cancelled
+ * @param progress if not nullptr, processing stops early when it says so (the state stays at the last applied operation)
+ * @throws std::invalid_argument if the format-code or the algorithm is invalid or the number of qubits doesn't match
+ */
+void QDDVer::load(const std::string& algo, unsigned int formatCode, unsigned int opNum, bool process, bool algo1,
+                  StepResult& result, Progress* progress) {
+    if(!dd) dd = PackagePool::acquire(dd::Matrix);
 
+    CircuitCache::Circuit circuit;
     try {
-        //second parameter describes the format of the algorithm
-        const unsigned int formatCode = (unsigned int)info[1].As<Napi::Number>();
+        //the format code describes the format of the algorithm
         qc::Format format;
         if(formatCode == 1)         format = qc::OpenQASM;
         else if(formatCode == 2)    format = qc::Real;
-        else {
-            Napi::Error::New(env, "Invalid format-code!").ThrowAsJavaScriptException();
-            return state;
-        }
+        else throw std::invalid_argument("Invalid format-code!");
 
-        if(algo1)   {
-            qc1->import(ss, format);
-            map1 = qc1->initialLayout;
-
-            //check if the number of qubits is the same for both algorithms
-            if(ready2 && qc1->getNqubits() != qc2->getNqubits()) {
-                //algo2 is already loaded (because ready2 is true), so we reset algo1
-                qc1->reset();
-                ready1 = false;
-                std::stringstream msg;
-                msg << "Number of qubits don't match! This algorithm needs " << qc2->getNqubits() << " qubits.";
-                Napi::Error::New(env, msg.str()).ThrowAsJavaScriptException();
-                return state;
-            }
-
-        } else {
-            qc2->import(ss, format);
-            map2 = qc2->initialLayout;
-
-            //check if the number of qubits is the same for both algorithms
-            if(ready1 && qc1->getNqubits() != qc2->getNqubits()) {
-                //algo1 is already loaded (because ready2 is true), so we reset algo2
-                qc2->reset();
-                ready2 = false;
-                std::stringstream msg;
-                msg << "Number of qubits don't match! This algorithm needs " << qc1->getNqubits() << " qubits.";
-                Napi::Error::New(env, msg.str()).ThrowAsJavaScriptException();
-                return state;
-            }
-        }
+        circuit = CircuitCache::get(algo, format);
 
+    } catch(std::invalid_argument&) {
+        throw;  //already has the message we want to show
     } catch(std::exception& e) {
         std::cout << "Exception while loading the algorithm: " << e.what() << std::endl;
         std::string err(e.what());
-        Napi::Error::New(env, "Invalid algorithm!\n" + err).ThrowAsJavaScriptException();
-        return state;
+        throw std::invalid_argument("Invalid algorithm!\n" + err);
     }
 
+    //check if the number of qubits is the same for both algorithms
+    const CircuitCache::Circuit& other = algo1 ? qc2 : qc1;
+    if((algo1 ? ready2 : ready1) && circuit->getNqubits() != other->getNqubits()) {
+        //the other algorithm is already loaded, so we reset this one (after removing its operations from sim)
+        if(algo1 ? ready1 : ready2) stepToStart(algo1);
+        checkpoints.dropFrom(*dd, algo1, 1);    //they contain operations of the algorithm that is reset now
+        if(algo1) {
+            qc1 = CircuitCache::empty();
+            ready1 = false;
+        } else {
+            qc2 = CircuitCache::empty();
+            ready2 = false;
+        }
+        std::stringstream msg;
+        msg << "Number of qubits don't match! This algorithm needs " << other->getNqubits() << " qubits.";
+        throw std::invalid_argument(msg.str());
+    }
+
+    if(opNum > circuit->getNops()) opNum = circuit->getNops();  //opNum may be bigger than the number of operations
+
+    //the operations before the first edited one have the same DDs and lead to the same matrix as before
+    const bool wasReady = algo1 ? ready1 : ready2;
+    const unsigned int unchanged = wasReady ? CircuitDiff::firstDifference(algo1 ? *qc1 : *qc2, *circuit) : 0;
+    const bool resimulate = process && wasReady && sim.p != nullptr && opNum > 0 && unchanged > 0;
+    bool restart = false;   //whether sim is the identity again
+
+    if(resimulate) {    //undo the edited operations with the previous algorithm, the unchanged ones stay applied
+        const unsigned int keep = std::min(unchanged, opNum);
+        StepResult undone;
+        if(algo1)   moveTo(std::min(position1, keep), position2, undone);
+        else        moveTo(position1, std::min(position2, keep), undone);
+        gc.endOfBatch(*dd);
+
     //if sim hasn't been set yet or only one algorithm is loaded (meaning the other isn't ready), we create its initial state/matrix
-    if(sim.p == nullptr || (algo1 && !ready2) || (!algo1 && !ready1)) {
-        //sim = dd->makeZeroState(qc->getNqubits());
-        if(algo1)   sim = qc1->createInitialMatrix(dd);
-        else        sim = qc2->createInitialMatrix(dd);
+    } else if(sim.p == nullptr || (algo1 && !ready2) || (!algo1 && !ready1)) {
+        if(sim.p != nullptr) dd->decRef(sim);
+        sim = initialMatrix(circuit);
         dd->incRef(sim);
+        identity.set(*dd, sim);
+        checkpoints.clear(*dd);     //the start is recorded again once the permutations are set
+        restart = true;
+
+        //the other algorithm isn't loaded, so none of its operations are part of the new sim
+        if(algo1) {
+            iterator2 = qc2->begin();
+            position2 = 0;
+        } else {
+            iterator1 = qc1->begin();
+            position1 = 0;
+        }
 
     } else {    //reset the previously loaded algorithm if process is true
         if(process) {
             try {
+                //the previous algorithm is still referenced by qc1/qc2, so its iterator stays valid
                 if(algo1 && ready1)         stepToStart(true);
                 else if(!algo1 && ready2)   stepToStart(false);
             } catch(std::exception& e) {
                 std::cout << "Exception while resetting algo" << (algo1 ? "1" : "2") << e.what() << std::endl;
                 std::string err(e.what());
-                Napi::Error::New(env, "Something went wrong with resetting the old algorithm.\n"
-                                      "Please try to load the algorithm again!" + err).ThrowAsJavaScriptException();
-                return state;
+                throw std::runtime_error("Something went wrong with resetting the old algorithm.\n"
+                                         "Please try to load the algorithm again!" + err);
+            }
+        }
+    }
+
+    if(algo1) {
+        gates1.dropFrom(*dd, unchanged);    //the cached DDs of edited operations belong to the previous algorithm
+        qc1 = circuit;
+        if(!resimulate) map1 = qc1->initialLayout;  //otherwise the permutation of the unchanged operations still applies
+    } else {
+        gates2.dropFrom(*dd, unchanged);    //the cached DDs of edited operations belong to the previous algorithm
+        qc2 = circuit;
+        if(!resimulate) map2 = qc2->initialLayout;  //otherwise the permutation of the unchanged operations still applies
+    }
+    checkpoints.dropFrom(*dd, algo1, unchanged + 1);    //they contain edited operations
+    if(!process)        checkpoints.clear(*dd);     //sim won't match the positions the iterator is advanced to
+    else if(restart)    checkpoints.record(*dd, {0, 0}, sim, map1, map2, true);
+
+    if(resimulate) {    //only the operations from the current position (at most unchanged) up to opNum are applied
+        if(algo1) {
+            iterator1 = qc1->begin() + position1;
+            atEnd1 = (iterator1 == qc1->end());
+        } else {
+            iterator2 = qc2->begin() + position2;
+            atEnd2 = (iterator2 == qc2->end());
+        }
+        while((algo1 ? position1 : position2) < opNum) {
+            stepForward(algo1);
+            if(progress != nullptr && progress->step(algo1 ? position1 : position2, *dd, sim)) {
+                result.cancelled = true;
+                break;
             }
         }
+        if(algo1)   atInitial1 = (position1 == 0);
+        else        atInitial2 = (position2 == 0);
+
+        gc.endOfBatch(*dd);
+        result.numOfOperations = circuit->getNops();
+        return;
     }
 
     //re-initialize some variables (though depending on opNum they might change in the next lines)
@@ -406,16 +620,19 @@ Napi::Value QDDVer::Load(const Napi::CallbackInfo& info) {
         position2 = 0;
     }
 
-    if(algo1 && opNum > qc1->getNops())         opNum = qc1->getNops();
-    else if(!algo1 && opNum > qc2->getNops())   opNum = qc2->getNops();
-
     std::cout << "opNum = " << opNum << std::endl;
     if(opNum > 0) {
         if(algo1)   atInitial1 = false;
         else        atInitial2 = false;
         if(process) {
             //apply some operations
-            for(unsigned int i = 0; i < opNum; i++) stepForward(algo1);
+            for(unsigned int i = 0; i < opNum; i++) {
+                stepForward(algo1);
+                if(progress != nullptr && progress->step(algo1 ? position1 : position2, *dd, sim)) {
+                    result.cancelled = true;
+                    break;
+                }
+            }
 
         } else {
             if(algo1) {
@@ -430,214 +647,387 @@ Napi::Value QDDVer::Load(const Napi::CallbackInfo& info) {
         }
     }
 
-    if(algo1)   state.Set("numOfOperations", Napi::Number::New(env, qc1->getNops()));
-    else        state.Set("numOfOperations", Napi::Number::New(env, qc2->getNops()));
+    gc.endOfBatch(*dd);
+    if(algo1)   result.numOfOperations = qc1->getNops();
+    else        result.numOfOperations = qc2->getNops();
+}
+
+/**Parameters: String algorithm, unsigned int formatCode, unsigned int num of operations to step forward, bool whether the
+ * operations should be processed or just the iterator needs to be advanced, whether we load algo1 or algo2
+ * Returns: object with members numOfOperations (-1 on error), verdict and nonIdentityNodes (see inspect)
+ *
+ * Tries to import the passed algorithm and returns whether it was successful or not. Additionally some operations/DDs can
+ * be applied or just the iterator advance forward without applying operations/DDs.
+ */
+Napi::Value QDDVer::Load(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("numOfOperations", Napi::Number::New(env, -1));
+    if(AsyncTask::isBusy(env, busy) || !checkLoadArguments(info)) return state;
+
+    const std::string algo = info[0].As<Napi::String>().Utf8Value();
+    const unsigned int formatCode = (unsigned int)info[1].As<Napi::Number>();
+    const unsigned int opNum = (unsigned int)info[2].As<Napi::Number>();
+    const bool process = (bool)info[3].As<Napi::Boolean>();
+    const bool algo1 = (bool)info[4].As<Napi::Boolean>();
+
+    try {
+        StepResult result;
+        load(algo, formatCode, opNum, process, algo1, result);
+        inspect(result);
+        state.Set("numOfOperations", Napi::Number::New(env, result.numOfOperations));
+        setInspection(env, state, result);
+    } catch(std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+    }
     return state;
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/**Removes all applied operations by taking steps back until atInitial is true.
- * atInitial will be true and in most cases atEnd will be false (special case for empty algorithms: atEnd is also true)
- * after this call.
+/**Same as Load, but the algorithm is imported and simulated on a worker thread.
  *
- * @param info whether the function should be applied to algo1 or algo2
- * @return true if the DD changed, false otherwise (nothing was done or an error occured)
+ * @param info same parameters as Load, optionally followed by an options object (see Progress)
+ * @return a Promise that resolves to the same object as Load returns with the additional member cancelled (true if
+ *          the simulation stopped before opNum was reached) or rejects with the error Load would throw
  */
-Napi::Value QDDVer::ToStart(const Napi::CallbackInfo& info) {
+Napi::Value QDDVer::LoadAsync(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    if(!checkLoadArguments(info)) return env.Undefined();
+
+    const std::string algo = info[0].As<Napi::String>().Utf8Value();
+    const unsigned int formatCode = (unsigned int)info[1].As<Napi::Number>();
+    const unsigned int opNum = (unsigned int)info[2].As<Napi::Number>();
+    const bool process = (bool)info[3].As<Napi::Boolean>();
+    const bool algo1 = (bool)info[4].As<Napi::Boolean>();
+
+    auto result = std::make_shared<StepResult>();
+    auto progress = std::make_shared<Progress>(env, info[5], cancelRequests);
+    return AsyncTask::start(info, busy,
+            [this, algo, formatCode, opNum, process, algo1, result, progress]() {
+                load(algo, formatCode, opNum, process, algo1, *result, progress.get());
+                inspect(*result);
+            },
+            [result](Napi::Env env) {
+                Napi::Object state = Napi::Object::New(env);
+                state.Set("numOfOperations", Napi::Number::New(env, result->numOfOperations));
+                state.Set("cancelled", Napi::Boolean::New(env, result->cancelled));
+                setInspection(env, state, *result);
+                return state;
+            });
+}
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Checks the algo1-parameter of the step functions and throws an error if it is invalid.
+ *
+ * @param info the parameters of the call
+ * @param algo1 is set to whether the function should be applied to algo1 or algo2
+ * @return true if the parameter is valid, false otherwise
+ */
+bool QDDVer::checkAlgoArgument(const Napi::CallbackInfo& info, bool& algo1) {
     if(info.Length() < 1) {
-        Napi::RangeError::New(env, "Need 1 (bool) argument!").ThrowAsJavaScriptException();
+        Napi::RangeError::New(info.Env(), "Need 1 (bool) argument!").ThrowAsJavaScriptException();
+        return false;
     }
     if (!info[0].IsBoolean()) {  //algo1
-        Napi::TypeError::New(env, "arg1: Boolean expected!").ThrowAsJavaScriptException();
+        Napi::TypeError::New(info.Env(), "arg1: Boolean expected!").ThrowAsJavaScriptException();
+        return false;
     }
-    bool algo1 = (bool)info[0].As<Napi::Boolean>();
+    algo1 = (bool)info[0].As<Napi::Boolean>();
+    return true;
+}
 
-    if(algo1) {
-        if(!ready1) {
-            //Napi::Error::New(env, "No algorithm loaded as algo1!").ThrowAsJavaScriptException();
-            std::cout << "not ready 1" << std::endl;
-            return Napi::Boolean::New(env, false);
-        } else if (qc1->empty()) {
-            std::cout << "empty 2" << std::endl;
-            return Napi::Boolean::New(env, false);
-        } else if(atInitial1) {
-            std::cout << "at initial 2" << std::endl;
-            return Napi::Boolean::New(env, false);  //nothing changed
-        }
+/**
+ *
+ * @param env the environment to create the object in
+ * @param result a result filled by one of the step functions
+ * @return object with members changed, verdict and nonIdentityNodes (see inspect, only if the DD changed)
+ */
+Napi::Object QDDVer::stepState(Napi::Env env, const StepResult& result) {
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("changed", Napi::Boolean::New(env, result.changed));
+    if(result.changed) setInspection(env, state, result);
+    return state;
+}
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Removes all applied operations of algo1 or algo2 by moving its iterator back to the start.
+ * atInitial will be true and in most cases atEnd will be false (special case for empty algorithms: atEnd is also true)
+ * after this call.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param algo1 whether the function should be applied to algo1 or algo2
+ * @param result is filled with changed, verdict and nonIdentityNodes
+ */
+void QDDVer::toStart(bool algo1, StepResult& result) {
+    if(algo1) {
+        if (qc1->empty() || atInitial1) return;  //nothing changed
         atEnd1 = false;  //now we are definitely not at the end (if there were no operation, so atInitial
         // and atEnd could be true at the same time, if(qc-empty) would already have returned
-
     } else {
-        if(!ready2) {
-            //Napi::Error::New(env, "No algorithm loaded as algo2!").ThrowAsJavaScriptException();
-            std::cout << "not ready 2" << std::endl;
-            return Napi::Boolean::New(env, false);
-        } else if (qc2->empty()) {
-            std::cout << "empty 2" << std::endl;
-            return Napi::Boolean::New(env, false);
-        } else if(atInitial2) {
-            std::cout << "atInitial 2" << std::endl;
-            return Napi::Boolean::New(env, false);  //nothing changed
-        }
-
+        if (qc2->empty() || atInitial2) return;  //nothing changed
         atEnd2 = false;  //now we are definitely not at the end (if there were no operation, so atInitial
         // and atEnd could be true at the same time, if(qc-empty) would already have returned
     }
 
-    try {
-        stepToStart(algo1);
-        return Napi::Boolean::New(env, true);   //something changed
+    stepToStart(algo1);
+    result.changed = true;   //something changed
+    inspect(result);
+}
+
+/**Removes all applied operations of algo1 or algo2 (see toStart). Nothing happens if the algorithm isn't loaded.
+ *
+ * @param info whether the function should be applied to algo1 or algo2
+ * @return object with members changed (true if the DD changed, false otherwise), verdict and nonIdentityNodes (see
+ *          inspect, only if the DD changed)
+ */
+Napi::Value QDDVer::ToStart(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    StepResult result;
+    if(AsyncTask::isBusy(env, busy)) return stepState(env, result);
+    bool algo1;
+    if(!checkAlgoArgument(info, algo1) || !isLoaded(algo1)) return stepState(env, result);
 
+    try {
+        toStart(algo1, result);
     } catch(std::exception& e) {
         std::cout << "Exception while going back to the start!" << std::endl;
         std::cout << e.what() << std::endl;
-        return Napi::Boolean::New(env, false);  //nothing changed
     }
+    return stepState(env, result);
+}
+
+/**Same as ToStart, but the iterator is moved on a worker thread.
+ *
+ * @param info whether the function should be applied to algo1 or algo2
+ * @return a Promise that resolves to the same object as ToStart returns
+ */
+Napi::Value QDDVer::ToStartAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool algo1;
+    if(!checkAlgoArgument(info, algo1)) return env.Undefined();
+
+    auto result = std::make_shared<StepResult>();
+    return AsyncTask::start(info, busy,
+            [this, algo1, result]() {
+                if(isLoaded(algo1)) toStart(algo1, *result);
+            },
+            [result](Napi::Env env) { return stepState(env, *result); });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**Goes back to the previous step of the simulation process by apllying the inverse of the last processed operation/DD.
  * If atInitial is true, nothing happens instead.
  * atEnd will be false and atInitial could end up being true, depending on the position.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
  *
- * @param info whether the function should be applied to algo1 or algo2
- * @return true if the DD changed, false otherwise (nothing was done or an error occured)
+ * @param algo1 whether the function should be applied to algo1 or algo2
+ * @param result is filled with changed, verdict and nonIdentityNodes
  */
-Napi::Value QDDVer::Prev(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    Napi::Object state = Napi::Object::New(env);
-    state.Set("changed", Napi::Boolean::New(env, false));
-
-    if(info.Length() < 1) {
-        Napi::RangeError::New(env, "Need 1 (bool) argument!").ThrowAsJavaScriptException();
-        return state;
-    }
-    if (!info[0].IsBoolean()) {  //algo1
-        Napi::TypeError::New(env, "arg1: Boolean expected!").ThrowAsJavaScriptException();
-        return state;
-    }
-    bool algo1 = (bool)info[0].As<Napi::Boolean>();
-
+void QDDVer::prev(bool algo1, StepResult& result) {
     if(algo1) {
-        if(!ready1) {
-            Napi::Error::New(env, "No algorithm loaded as algo1!").ThrowAsJavaScriptException();
-            return state;
-        } else if (qc1->empty()) {
-            return state;
-        }
+        if (qc1->empty()) return;
 
         if (atEnd1) {
             atEnd1 = false;
         } else if (atInitial1) {
-            return state; //we can't go any further back
+            return; //we can't go any further back
         }
     } else {
-        if(!ready2) {
-            Napi::Error::New(env, "No algorithm loaded as algo2!").ThrowAsJavaScriptException();
-            return state;
-        } else if (qc2->empty()) {
-            return state;
-        }
+        if (qc2->empty()) return;
 
         if (atEnd2) {
             atEnd2 = false;
         } else if (atInitial2) {
-            return state; //we can't go any further back
+            return; //we can't go any further back
         }
     }
 
-    try {
-        state.Set("changed", true);   //something changed
-        stepBack(algo1);     //go back to the start before the last processed operation
+    result.changed = true;   //something changed
+    stepBack(algo1);     //go back to the start before the last processed operation
+    gc.endOfBatch(*dd);
+    inspect(result);
+}
 
-        return state;
+/**Goes back to the previous step of algo1 or algo2 (see prev).
+ *
+ * @param info whether the function should be applied to algo1 or algo2
+ * @return object with members changed (true if the DD changed, false otherwise), verdict and nonIdentityNodes (see
+ *          inspect, only if the DD changed)
+ */
+Napi::Value QDDVer::Prev(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    StepResult result;
+    if(AsyncTask::isBusy(env, busy)) return stepState(env, result);
+    bool algo1;
+    if(!checkAlgoArgument(info, algo1)) return stepState(env, result);
+    if(!isLoaded(algo1)) {
+        Napi::Error::New(env, algo1 ? "No algorithm loaded as algo1!" : "No algorithm loaded as algo2!").ThrowAsJavaScriptException();
+        return stepState(env, result);
+    }
 
+    try {
+        prev(algo1, result);
     } catch(std::exception& e) {
-        std::cout << "Exception while getting the current operation {src: prev}!" << e.what() << std::endl;
+        std::cout << "Exception while getting the current operation {src: prev}!" << std::endl;
         std::cout << e.what() << std::endl;
-        return state;
     }
+    return stepState(env, result);
+}
+
+/**Same as Prev, but the operation is undone on a worker thread.
+ *
+ * @param info whether the function should be applied to algo1 or algo2
+ * @return a Promise that resolves to the same object as Prev returns
+ */
+Napi::Value QDDVer::PrevAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool algo1;
+    if(!checkAlgoArgument(info, algo1)) return env.Undefined();
+
+    auto result = std::make_shared<StepResult>();
+    return AsyncTask::start(info, busy,
+            [this, algo1, result]() {
+                if(!isLoaded(algo1)) throw std::runtime_error(algo1 ? "No algorithm loaded as algo1!" : "No algorithm loaded as algo2!");
+                prev(algo1, *result);
+            },
+            [result](Napi::Env env) { return stepState(env, *result); });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**Goes forward to the next step of the simulation process by applying the current operation/DD.
  * If atEnd is true, nothing happens instead.
  * atInitial will be false and atEnd could end up being true, depending on the position.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
  *
- * @param info whether the function should be applied to algo1 or algo2
- * @return true if the DD changed, false otherwise (nothing was done or an error occured)
+ * @param algo1 whether the function should be applied to algo1 or algo2
+ * @param result is filled with changed, verdict and nonIdentityNodes
  */
-Napi::Value QDDVer::Next(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    Napi::Object state = Napi::Object::New(env);
-    state.Set("changed", Napi::Boolean::New(env, false));
-
-    if(info.Length() < 1) {
-        Napi::RangeError::New(env, "Need 1 (bool) argument!").ThrowAsJavaScriptException();
-        return state;
-    }
-    if (!info[0].IsBoolean()) {  //algo1
-        Napi::TypeError::New(env, "arg1: Boolean expected!").ThrowAsJavaScriptException();
-        return state;
-    }
-    bool algo1 = (bool)info[0].As<Napi::Boolean>();
-
+void QDDVer::next(bool algo1, StepResult& result) {
     if(algo1) {
-        if(!ready1) {
-            Napi::Error::New(env, "No algorithm loaded as algo1!").ThrowAsJavaScriptException();
-            return state;
-        } else if (qc1->empty()) {
-            return state;
-        }
+        if (qc1->empty()) return;
 
         if(atInitial1) {
             atInitial1 = false;
         } else if(atEnd1) {
-            return state;
+            return;
         }
     } else {
-        if(!ready2) {
-            Napi::Error::New(env, "No algorithm loaded as algo2!").ThrowAsJavaScriptException();
-            return state;
-        } else if (qc2->empty()) {
-            return state;
-        }
+        if (qc2->empty()) return;
 
         if(atInitial2){
             atInitial2 = false;
         } else if(atEnd2) {
-            return state;
+            return;
         }
     }
 
-    try {
-        state.Set("changed", Napi::Boolean::New(env, true));
-        stepForward(algo1);          //process the next operation
+    result.changed = true;
+    stepForward(algo1);          //process the next operation
+    gc.endOfBatch(*dd);
+    inspect(result);
+}
 
-        return state;
+/**Goes forward to the next step of algo1 or algo2 (see next).
+ *
+ * @param info whether the function should be applied to algo1 or algo2
+ * @return object with members changed (true if the DD changed, false otherwise), verdict and nonIdentityNodes (see
+ *          inspect, only if the DD changed)
+ */
+Napi::Value QDDVer::Next(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    StepResult result;
+    if(AsyncTask::isBusy(env, busy)) return stepState(env, result);
+    bool algo1;
+    if(!checkAlgoArgument(info, algo1)) return stepState(env, result);
+    if(!isLoaded(algo1)) {
+        Napi::Error::New(env, algo1 ? "No algorithm loaded as algo1!" : "No algorithm loaded as algo2!").ThrowAsJavaScriptException();
+        return stepState(env, result);
+    }
 
+    try {
+        next(algo1, result);
     } catch(std::exception& e) {
         std::cout << "Exception while getting the current operation {src: next}!" << std::endl;
         std::cout << e.what() << std::endl;
-        return state;
     }
+    return stepState(env, result);
+}
+
+/**Same as Next, but the operation is applied on a worker thread.
+ *
+ * @param info whether the function should be applied to algo1 or algo2
+ * @return a Promise that resolves to the same object as Next returns
+ */
+Napi::Value QDDVer::NextAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    bool algo1;
+    if(!checkAlgoArgument(info, algo1)) return env.Undefined();
+
+    auto result = std::make_shared<StepResult>();
+    return AsyncTask::start(info, busy,
+            [this, algo1, result]() {
+                if(!isLoaded(algo1)) throw std::runtime_error(algo1 ? "No algorithm loaded as algo1!" : "No algorithm loaded as algo2!");
+                next(algo1, *result);
+            },
+            [result](Napi::Env env) { return stepState(env, *result); });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Processes all operations of algo1 or algo2 until its iterator points to the very end.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param algo1 whether the function should be applied to algo1 or algo2
+ * @param result is filled with changed and cancelled
+ * @param progress if not nullptr, processing stops early when it says so (the state stays at the last applied operation)
+ */
+void QDDVer::toEnd(bool algo1, StepResult& result, Progress* progress) {
+    if(algo1) {
+        if (qc1->empty() || atEnd1) return; //nothing changed
+        atInitial1 = false;  //now we are definitely not at the beginning (if there were no operation, so atInitial
+        // and atEnd could be true at the same time, if(qc-empty) would already have returned
+        result.changed = true;
+
+        //process one step at a time until all operations have been considered (atEnd is set to true in stepForward())
+        while(!atEnd1) {
+            stepForward(true);
+            if(progress != nullptr && progress->step(position1, *dd, sim)) {
+                result.cancelled = true;
+                break;
+            }
+        }
+        //now atEnd is true, exactly as it should be (unless we were cancelled)
+
+    } else {
+        if (qc2->empty() || atEnd2) return; //nothing changed
+        atInitial2 = false;  //now we are definitely not at the beginning (if there were no operation, so atInitial
+                            // and atEnd could be true at the same time, if(qc-empty) would already have returned
+        result.changed = true;
+
+        //process one step at a time until all operations have been considered (atEnd is set to true in stepForward())
+        while(!atEnd2) {
+            stepForward(false);
+            if(progress != nullptr && progress->step(position2, *dd, sim)) {
+                result.cancelled = true;
+                break;
+            }
+        }
+        //now atEnd is true, exactly as it should be (unless we were cancelled)
+    }
+    gc.endOfBatch(*dd);
+}
+
 /**Processes all operations until the iterator points to the very end.
  * atEnd will be true and in most cases atInitial will be false (special case for empty algorithms: atInitial is also true)
  * after this call.
  *
  * @param info whether the function should be applied to algo1 or algo2
- * @return true if the DD changed, false otherwise (nothing was done or an error occured)
+ * @return object with members changed (true if the DD changed, false otherwise), verdict and nonIdentityNodes (see
+ *          inspect)
  */
 Napi::Value QDDVer::ToEnd(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     Napi::Object state = Napi::Object::New(env);
     state.Set("changed", Napi::Boolean::New(env, false));
+    if(AsyncTask::isBusy(env, busy)) return state;
 
     if(info.Length() < 1) {
         Napi::RangeError::New(env, "Need 1 (bool) argument!").ThrowAsJavaScriptException();
@@ -649,52 +1039,71 @@ Napi::Value QDDVer::ToEnd(const Napi::CallbackInfo& info) {
     }
     bool algo1 = (bool)info[0].As<Napi::Boolean>();
 
-    if(algo1) {
-        if(!ready1) {
-            Napi::Error::New(env, "No algorithm loaded as algo1!").ThrowAsJavaScriptException();
-            return state;
-        } else if (qc1->empty()) {
-            return state;
-        } else if(atEnd1) {
-            return state; //nothing changed
-        }
-
-        atInitial1 = false;  //now we are definitely not at the beginning (if there were no operation, so atInitial
-        // and atEnd could be true at the same time, if(qc-empty) would already have returned
-
-    } else {
-        if(!ready2) {
-            Napi::Error::New(env, "No algorithm loaded as algo2!").ThrowAsJavaScriptException();
-            return state;
-        } else if (qc2->empty()) {
-            return state;
-        } else if(atEnd2) {
-            return state; //nothing changed
-        }
-
-        atInitial2 = false;  //now we are definitely not at the beginning (if there were no operation, so atInitial
-                            // and atEnd could be true at the same time, if(qc-empty) would already have returned
+    if(!isLoaded(algo1)) {
+        Napi::Error::New(env, algo1 ? "No algorithm loaded as algo1!" : "No algorithm loaded as algo2!").ThrowAsJavaScriptException();
+        return state;
     }
 
+    StepResult result;
     try {
-        state.Set("changed", Napi::Boolean::New(env, true));  //something changed
-        if(algo1) {
-            //process one step at a time until all operations have been considered (atEnd is set to true in stepForward())
-            while(!atEnd1) stepForward(true);
-            //now atEnd is true, exactly as it should be
-        } else {
-            //process one step at a time until all operations have been considered (atEnd is set to true in stepForward())
-            while(!atEnd2) stepForward(false);
-            //now atEnd is true, exactly as it should be
-        }
-
-        return state;
-
+        toEnd(algo1, result);
     } catch(std::exception& e) {
         std::cout << "Exception while going to the end!" << std::endl;
         std::cout << e.what() << std::endl;
-        return state;
     }
+    inspect(result);
+    state.Set("changed", Napi::Boolean::New(env, result.changed));
+    setInspection(env, state, result);
+    return state;
+}
+
+/**Same as ToEnd, but the operations are processed on a worker thread.
+ *
+ * @param info whether the function should be applied to algo1 or algo2 and an optional options object (see Progress)
+ * @return a Promise that resolves to the same object as ToEnd returns with the additional member cancelled, which is
+ *          true if the processing stopped early because of Cancel or the timeout
+ */
+Napi::Value QDDVer::ToEndAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(info.Length() < 1 || !info[0].IsBoolean()) {
+        Napi::TypeError::New(env, "arg1: Boolean expected!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    bool algo1 = (bool)info[0].As<Napi::Boolean>();
+
+    auto result = std::make_shared<StepResult>();
+    auto progress = std::make_shared<Progress>(env, info[1], cancelRequests);
+    return AsyncTask::start(info, busy,
+            [this, algo1, result, progress]() {
+                if(!isLoaded(algo1)) throw std::runtime_error(algo1 ? "No algorithm loaded as algo1!" : "No algorithm loaded as algo2!");
+                toEnd(algo1, *result, progress.get());
+                inspect(*result);
+            },
+            [result](Napi::Env env) {
+                Napi::Object state = Napi::Object::New(env);
+                state.Set("changed", Napi::Boolean::New(env, result->changed));
+                state.Set("cancelled", Napi::Boolean::New(env, result->cancelled));
+                setInspection(env, state, *result);
+                return state;
+            });
+}
+
+/**Moves the iterator of algo1 or algo2 to the given position, starting from the nearest checkpoint (see moveTo) and
+ * applying inverse operations/DDs like Prev or operations/DDs normally like Next from there.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param targetPos the position the iterator should point at after this call (clamped to the number of operations)
+ * @param algo1 whether the function should be applied to algo1 or algo2
+ * @param result is filled with changed and cancelled
+ * @param progress if not nullptr, processing stops early when it says so (the state stays at the last applied operation)
+ */
+void QDDVer::toLine(unsigned int targetPos, bool algo1, StepResult& result, Progress* progress) {
+    const CircuitCache::Circuit& circuit = algo1 ? qc1 : qc2;
+    if(targetPos > circuit->getNops()) targetPos = circuit->getNops();    //we can't go further than to the end
+
+    if(algo1)   moveTo(targetPos, position2, result, progress);
+    else        moveTo(position1, targetPos, result, progress);
+    gc.endOfBatch(*dd);
 }
 
 /**Depending on the current position of the iterator and the given parameter this function either applies inverse
@@ -704,62 +1113,40 @@ Napi::Value QDDVer::ToEnd(const Napi::CallbackInfo& info) {
  * @param info takes two parameter
  *              int: determines to which position the iterator should point at after this call
  *              bool: whether the function should be applied to algo1 or algo2
- * @return true if the DD changed, false otherwise (nothing was done or an error occured)
+ * @return object with members changed (true if the DD changed, false otherwise), verdict and nonIdentityNodes (see
+ *          inspect)
  */
 Napi::Value QDDVer::ToLine(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("changed", Napi::Boolean::New(env, false));
+    if(AsyncTask::isBusy(env, busy)) return state;
 
     //check if the correct parameters have been passed
     if(info.Length() < 2) {
         Napi::RangeError::New(env, "Need 2 (unsigned int, bool) arguments!").ThrowAsJavaScriptException();
-        return Napi::Boolean::New(env, false);
+        return state;
     }
     if (!info[0].IsNumber()) {  //line number/position
         Napi::TypeError::New(env, "arg1: unsigned int expected!").ThrowAsJavaScriptException();
-        return Napi::Boolean::New(env, false);
+        return state;
     }
     if (!info[1].IsBoolean()) {  //algo1
         Napi::TypeError::New(env, "arg1: Boolean expected!").ThrowAsJavaScriptException();
+        return state;
     }
 
-    unsigned int param = (unsigned int)info[0].As<Napi::Number>();
+    const unsigned int targetPos = (unsigned int)info[0].As<Napi::Number>();
     bool algo1 = (bool)info[1].As<Napi::Boolean>();
 
-    if(algo1) {
-        if(param > qc1->getNops()) param = qc1->getNops();    //we can't go further than to the end
-    } else {
-        if(param > qc2->getNops()) param = qc2->getNops();    //we can't go further than to the end
-    }
-    const unsigned int targetPos = param;
-
     try {
-        if(algo1) {
-            if(position1 == targetPos) return Napi::Boolean::New(env, false);   //nothing changed
-
-            //only one of the two loops can be entered
-            while(position1 > targetPos) stepBack(true);
-            while(position1 < targetPos) stepForward(true);
-
-            atInitial1 = false;
-            atEnd1 = false;
-            if(position1 == 0) atInitial1 = true;
-            if(position1 == qc1->getNops()) atEnd1 = true;
-
-        } else {
-            if(position2 == targetPos) return Napi::Boolean::New(env, false);   //nothing changed
-
-            //only one of the two loops can be entered
-            while(position2 > targetPos) stepBack(false);
-            while(position2 < targetPos) stepForward(false);
-
-            atInitial2 = false;
-            atEnd2 = false;
-            if(position2 == 0) atInitial2 = true;
-            if(position2 == qc2->getNops()) atEnd2 = true;
-        }
-
-        return Napi::Boolean::New(env, true);   //something changed
+        StepResult result;
+        toLine(targetPos, algo1, result);
+        inspect(result);
+        state.Set("changed", Napi::Boolean::New(env, result.changed));
+        setInspection(env, state, result);
+        return state;
 
     } catch(std::exception& e) {
         std::string msg = "Exception while going to line ";// + position + " to " + targetPos;
@@ -770,11 +1157,65 @@ Napi::Value QDDVer::ToLine(const Napi::CallbackInfo &info) {
         std::cout << "Exception while going from " << (algo1 ? position1 : position2) << " to " << targetPos << std::endl;
         std::cout << e.what() << std::endl;
         Napi::Error::New(env, msg).ThrowAsJavaScriptException();
-        return Napi::Boolean::New(env, false);
+        return state;
     }
 }
 
+/**Same as ToLine, but the operations are applied or undone on a worker thread.
+ *
+ * @param info same parameters as ToLine, optionally followed by an options object (see Progress)
+ * @return a Promise that resolves to the same object as ToLine returns with the additional member cancelled (a
+ *          cancelled call reports whether the DD changed before it stopped)
+ */
+Napi::Value QDDVer::ToLineAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if(info.Length() < 2 || !info[0].IsNumber() || !info[1].IsBoolean()) {
+        Napi::TypeError::New(env, "Need 2 (unsigned int, bool) arguments!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    const unsigned int targetPos = (unsigned int)info[0].As<Napi::Number>();
+    bool algo1 = (bool)info[1].As<Napi::Boolean>();
+
+    auto result = std::make_shared<StepResult>();
+    auto progress = std::make_shared<Progress>(env, info[2], cancelRequests);
+    return AsyncTask::start(info, busy,
+            [this, targetPos, algo1, result, progress]() {
+                toLine(targetPos, algo1, *result, progress.get());
+                inspect(*result);
+            },
+            [result](Napi::Env env) {
+                Napi::Object state = Napi::Object::New(env);
+                state.Set("changed", Napi::Boolean::New(env, result->changed));
+                state.Set("cancelled", Napi::Boolean::New(env, result->cancelled));
+                setInspection(env, state, *result);
+                return state;
+            });
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Exports the current state of the verification with the current export options.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @return the current state of the verification as DD in the .dot-format (shared with the export cache)
+ */
+ExportCache::Dot QDDVer::exportDD() {
+    const unsigned int options = (showColors ? 1u : 0u) | (showEdgeLabels ? 2u : 0u) | (showClassic ? 4u : 0u);
+    return exports.dot(*dd, sim, options, [this]() {
+        std::stringstream ss{};
+        dd::toDot(sim, ss, false, this->showColors, this->showEdgeLabels, this->showClassic);
+        return ss.str();
+    });
+}
+
+/**Exports the current state as binary node table (see DDSerializer).
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @return the serialized DD (shared with the export cache)
+ */
+ExportCache::Binary QDDVer::exportBinary() {
+    return exports.binary(*dd, sim, [this]() { return DDSerializer::serialize(sim, false); });
+}
+
 /**Creates a DD in the .dot-format for the current state of the simulation.
  *
  * @param info has no parameters
@@ -782,16 +1223,14 @@ Napi::Value QDDVer::ToLine(const Napi::CallbackInfo &info) {
  */
 Napi::Value QDDVer::GetDD(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return Napi::String::New(env, "-1");
     if(!ready1 && !ready2) {
         Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
         return Napi::String::New(env, "-1");
     }
 
-    std::stringstream ss{};
     try {
-        dd::toDot(sim, ss, false, this->showColors, this->showEdgeLabels, this->showClassic);
-        std::string str = ss.str();
-        return Napi::String::New(env, str);
+        return Napi::String::New(env, *exportDD());
 
     } catch(std::exception& e) {
         std::cout << "Exception while getting the DD: " << e.what() << std::endl;
@@ -802,6 +1241,172 @@ Napi::Value QDDVer::GetDD(const Napi::CallbackInfo& info) {
     }
 }
 
+/**Same as GetDD, but the DD is exported on a worker thread.
+ *
+ * @param info has no parameters
+ * @return a Promise that resolves to the string GetDD returns
+ */
+Napi::Value QDDVer::GetDDAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<ExportCache::Dot>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready1 && !ready2) throw std::runtime_error("No algorithm loaded!");
+                *result = exportDD();
+            },
+            [result](Napi::Env env) { return Napi::String::New(env, **result); });
+}
+
+/**Creates the current DD as compact binary node table (see DDSerializer for the layout). Unlike GetDD it doesn't
+ * depend on the export options, since colors and labels are up to the client.
+ *
+ * @param info has no parameters
+ * @return Uint8Array containing the serialized DD
+ */
+Napi::Value QDDVer::GetDDBinary(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready1 && !ready2) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return DDSerializer::toUint8Array(env, exportBinary());
+}
+
+/**Same as GetDDBinary, but the DD is serialized on a worker thread.
+ *
+ * @param info has no parameters
+ * @return a Promise that resolves to the Uint8Array GetDDBinary returns
+ */
+Napi::Value QDDVer::GetDDBinaryAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<ExportCache::Binary>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready1 && !ready2) throw std::runtime_error("No algorithm loaded!");
+                *result = exportBinary();
+            },
+            [result](Napi::Env env) { return DDSerializer::toUint8Array(env, *result); });
+}
+
+/**Exports the current DD as difference to the DD of the previous GetDDDiff-call (see DDDiff), so stepping only
+ * transfers the nodes that actually changed.
+ *
+ * @param info has an optional boolean argument (full) - if it is true, the diff starts from the empty graph (e.g. because
+ *          the client lost track of its version)
+ * @return null if the DD is structurally identical to the last export, otherwise the object described in
+ *          DDDiff::toObject
+ */
+Napi::Value QDDVer::GetDDDiff(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready1 && !ready2) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if(info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>()) ddDiff.clear(*dd);
+    return DDDiff::toObject(env, ddDiff.diff(*dd, sim, false));
+}
+
+/**Same as GetDDDiff, but the diff is computed on a worker thread.
+ *
+ * @param info has an optional boolean argument (full), see GetDDDiff
+ * @return a Promise that resolves to what GetDDDiff returns
+ */
+Napi::Value QDDVer::GetDDDiffAsync(const Napi::CallbackInfo& info) {
+    const bool full = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>();
+    auto result = std::make_shared<DDDiff::Result>();
+    return AsyncTask::start(info, busy,
+            [this, result, full]() {
+                if(!ready1 && !ready2) throw std::runtime_error("No algorithm loaded!");
+                if(full) ddDiff.clear(*dd);
+                *result = ddDiff.diff(*dd, sim, false);
+            },
+            [result](Napi::Env env) { return DDDiff::toObject(env, *result); });
+}
+
+/**Lays out the current DD (see Layout), so the client only has to draw it. Nodes that were part of the previous
+ * layout keep their ids and stay where they were as far as possible.
+ *
+ * @param info has an optional boolean argument (fresh) - if it is true, the previous layout is ignored
+ * @return the object described in Layout::toObject
+ */
+Napi::Value QDDVer::GetLayout(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready1 && !ready2) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if(info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>()) graphLayout.clear(*dd);
+    return Layout::toObject(env, graphLayout.layout(*dd, sim, false));
+}
+
+/**Same as GetLayout, but the layout is computed on a worker thread.
+ *
+ * @param info has an optional boolean argument (fresh), see GetLayout
+ * @return a Promise that resolves to what GetLayout returns
+ */
+Napi::Value QDDVer::GetLayoutAsync(const Napi::CallbackInfo& info) {
+    const bool fresh = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>();
+    auto result = std::make_shared<Layout::Result>();
+    return AsyncTask::start(info, busy,
+            [this, result, fresh]() {
+                if(!ready1 && !ready2) throw std::runtime_error("No algorithm loaded!");
+                if(fresh) graphLayout.clear(*dd);
+                *result = graphLayout.layout(*dd, sim, false);
+            },
+            [result](Napi::Env env) { return Layout::toObject(env, *result); });
+}
+
+/**Exports the current DD with at most a given number of expanded nodes (see LevelOfDetail), the rest is collapsed
+ * into summary nodes.
+ *
+ * @param info has an optional object argument {budget, expand}, see LevelOfDetail::parseOptions
+ * @return the object described in LevelOfDetail::toObject
+ */
+Napi::Value QDDVer::GetDDSummary(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready1 && !ready2) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    unsigned int budget;
+    std::vector<std::uint32_t> expand;
+    if(!LevelOfDetail::parseOptions(info, budget, expand)) return env.Undefined();
+    return LevelOfDetail::toObject(env, levelOfDetail.build(*dd, sim, false, budget, expand));
+}
+
+/**Same as GetDDSummary, but the export is computed on a worker thread.
+ *
+ * @param info has an optional object argument {budget, expand}, see LevelOfDetail::parseOptions
+ * @return a Promise that resolves to what GetDDSummary returns
+ */
+Napi::Value QDDVer::GetDDSummaryAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    unsigned int budget;
+    auto expand = std::make_shared<std::vector<std::uint32_t>>();
+    if(!LevelOfDetail::parseOptions(info, budget, *expand)) return env.Undefined();
+    auto result = std::make_shared<LevelOfDetail::Result>();
+    return AsyncTask::start(info, busy,
+            [this, result, budget, expand]() {
+                if(!ready1 && !ready2) throw std::runtime_error("No algorithm loaded!");
+                *result = levelOfDetail.build(*dd, sim, false, budget, *expand);
+            },
+            [result](Napi::Env env) { return LevelOfDetail::toObject(env, *result); });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Asks the running asynchronous call (loadAsync, toEndAsync or toLineAsync) to stop after the operation it is currently
+ * applying. Its Promise then resolves normally and the state stays at the last applied operation. Calls that are still
+ * queued behind it are cancelled as well (they stop right away once they start), calls made afterwards aren't.
+ * Does nothing if no asynchronous call is running.
+ *
+ * @param info has no parameters
+ */
+void QDDVer::Cancel(const Napi::CallbackInfo& info) {
+    if(busy) cancelRequests++;
+}
+
 /**Updates the three fields of this object that determine with which options the DD should be exported (on the next
  * GetDD-call).
  *
@@ -809,6 +1414,7 @@ Napi::Value QDDVer::GetDD(const Napi::CallbackInfo& info) {
  */
 void QDDVer::UpdateExportOptions(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return;
     //check if the correct parameters have been passed
     if(info.Length() != 3) {
         Napi::RangeError::New(env, "Need 3 (bool, bool, bool) arguments!").ThrowAsJavaScriptException();
@@ -864,8 +1470,14 @@ Napi::Value QDDVer::IsReady(const Napi::CallbackInfo& info) {
     else        return Napi::Boolean::New(env, this->ready2);
 }
 
+/**Marks one algorithm as not ready. Once neither is ready, the dd::Package is given back to the pool and the next load
+ * acquires a new one.
+ *
+ * @param info has one boolean argument (algo1)
+ */
 void QDDVer::Unready(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return;
 
     if(info.Length() < 1) {
         //if no parameter is given, check if one of the two algos are ready, meaning a DD can be shown
@@ -879,6 +1491,429 @@ void QDDVer::Unready(const Napi::CallbackInfo& info) {
 
     if(algo1)   this->ready1 = false;
     else        this->ready2 = false;
+    if(!ready1 && !ready2) releasePackage();
+}
+
+/**Marks both algorithms as not ready and gives the dd::Package back to the pool, used when the session is cleaned up.
+ *
+ * @param info has no parameters
+ */
+void QDDVer::Release(const Napi::CallbackInfo& info) {
+    if(AsyncTask::isBusy(info.Env(), busy)) return;
+    releasePackage();
+}
+
+/**Dereferences all DDs of this object and returns its dd::Package to the pool (if it has one).
+ *
+ */
+void QDDVer::releasePackage() {
+    ready1 = false;
+    ready2 = false;
+    if(!dd) return;
+
+    gates1.clear(*dd);
+    gates2.clear(*dd);
+    ddDiff.clear(*dd);
+    exports.clear(*dd);
+    graphLayout.clear(*dd);
+    levelOfDetail.clear(*dd);
+    checkpoints.clear(*dd);
+    identity.clear(*dd);
+    if(sim.p != nullptr) dd->decRef(sim);
+    sim = dd::Edge{};
+    PackagePool::release(std::move(dd));
+}
+
+QDDVer::~QDDVer() {
+    releasePackage();
+}
+
+/**Measures the memory this object currently holds and remembers it for calls while an asynchronous call is busy.
+ *
+ * @return the estimated memory usage of this object
+ */
+MemoryUsage QDDVer::measureMemory() {
+    memory = MemoryUsage::of(dd.get(), exports.getBytes());
+    return memory;
+}
+
+/**Returns the memory usage of the last measurement while an asynchronous call is working on this object, since its
+ * package must not be read meanwhile.
+ *
+ * @param info has no parameters
+ * @return object as described in MemoryUsage::toObject, extended by the members
+ *          busy: whether an asynchronous call is running (and the values are therefore from an earlier measurement)
+ *          gateCacheEntries: number of operation DDs stored for both algorithms together
+ *          checkpoints: number of states stored for random access
+ */
+Napi::Value QDDVer::GetMemoryUsage(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const bool running = busy;
+    Napi::Object obj = (running ? memory : measureMemory()).toObject(env);
+    obj.Set("busy", Napi::Boolean::New(env, running));
+    obj.Set("gateCacheEntries", Napi::Number::New(env, running ? 0 : gates1.size() + gates2.size()));
+    obj.Set("checkpoints", Napi::Number::New(env, running ? 0 : checkpoints.size()));
+    return obj;
+}
+
+/**Frees as much memory as possible without losing the current state: drops all caches and the checkpoints that are
+ * not pinned and forces a garbage collection. Used by the server to shrink sessions that weren't accessed for a while.
+ *
+ * @param info has no parameters
+ * @return number of bytes that were freed (estimated as in MemoryUsage)
+ */
+Napi::Value QDDVer::Compact(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+
+    const std::size_t before = measureMemory().bytes;
+    if(dd) {
+        gates1.clear(*dd);
+        gates2.clear(*dd);
+        ddDiff.clear(*dd);
+        exports.clear(*dd);
+        graphLayout.clear(*dd);
+        levelOfDetail.clear(*dd);
+        checkpoints.dropUnpinned(*dd);
+        dd->garbageCollect(true);
+    }
+    const std::size_t after = measureMemory().bytes;
+    return Napi::Number::New(env, before > after ? before - after : 0);
+}
+
+/**
+ *
+ * @param info has no parameters
+ * @return object with members
+ *          gateCache1, gateCache2: {hits, misses, entries, nodes} of the caches for the DDs of the operations of algo1
+ *                                  and algo2
+ *          exportCache: {hits, misses, entries, bytes} of the cache for the exported DDs
+ *          circuitCache: {hits, misses, entries} of the process-wide cache of parsed algorithms
+ *          scheduler: {workers, pending} number of worker threads and of asynchronous calls queued by all sessions
+ *          gc: {mode, parameter, runs, nodesFreed, time (in µs)} of the garbage collection
+ */
+Napi::Value QDDVer::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+
+    Napi::Object stats = Napi::Object::New(env);
+    for(int i = 1; i <= 2; i++) {
+        const GateCache& gates = i == 1 ? gates1 : gates2;
+        Napi::Object gateCache = Napi::Object::New(env);
+        gateCache.Set("hits", Napi::Number::New(env, gates.getHits()));
+        gateCache.Set("misses", Napi::Number::New(env, gates.getMisses()));
+        gateCache.Set("entries", Napi::Number::New(env, gates.size()));
+        gateCache.Set("nodes", Napi::Number::New(env, gates.getNodes()));
+        stats.Set(i == 1 ? "gateCache1" : "gateCache2", gateCache);
+    }
+
+    Napi::Object exportCache = Napi::Object::New(env);
+    exportCache.Set("hits", Napi::Number::New(env, exports.getHits()));
+    exportCache.Set("misses", Napi::Number::New(env, exports.getMisses()));
+    exportCache.Set("entries", Napi::Number::New(env, exports.size()));
+    exportCache.Set("bytes", Napi::Number::New(env, exports.getBytes()));
+    stats.Set("exportCache", exportCache);
+
+    Napi::Object circuitCache = Napi::Object::New(env);
+    circuitCache.Set("hits", Napi::Number::New(env, CircuitCache::getHits()));
+    circuitCache.Set("misses", Napi::Number::New(env, CircuitCache::getMisses()));
+    circuitCache.Set("entries", Napi::Number::New(env, CircuitCache::size()));
+    stats.Set("circuitCache", circuitCache);
+
+    Napi::Object scheduler = Napi::Object::New(env);
+    scheduler.Set("workers", Napi::Number::New(env, Scheduler::get().getWorkers()));
+    scheduler.Set("pending", Napi::Number::New(env, Scheduler::get().getPending()));
+    stats.Set("scheduler", scheduler);
+
+    Napi::Object gcStats = Napi::Object::New(env);
+    gcStats.Set("mode", Napi::String::New(env, GCPolicy::modeName(gc.getMode())));
+    gcStats.Set("parameter", Napi::Number::New(env, gc.getParameter()));
+    gcStats.Set("runs", Napi::Number::New(env, gc.getRuns()));
+    gcStats.Set("nodesFreed", Napi::Number::New(env, gc.getNodesFreed()));
+    gcStats.Set("time", Napi::Number::New(env, gc.getTime()));
+    stats.Set("gc", gcStats);
+    return stats;
+}
+
+/**Sets when the garbage collection runs while stepping through the algorithms (see GCPolicy).
+ *
+ * @param info takes two parameters
+ *              string: "everyStep" (default), "everyNSteps", "nodeThreshold" or "endOfBatch"
+ *              unsigned int: number of steps for everyNSteps, number of nodes for nodeThreshold (optional otherwise)
+ */
+void QDDVer::SetGCPolicy(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return;
+    if(info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "arg1: String expected!").ThrowAsJavaScriptException();
+        return;
+    }
+    const unsigned long parameter = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int64Value() : 0;
+    if(!gc.setMode(info[0].As<Napi::String>().Utf8Value(), parameter)) {
+        Napi::Error::New(env, "Invalid GC policy!").ThrowAsJavaScriptException();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Decides which algorithm the next operation of an equivalence check is taken from. At least one of them must have
+ * operations left.
+ *
+ * @param strategy the strategy of the check
+ * @param lastWasAlgo1 whether the previous operation was taken from algo1
+ * @return true if the next operation of algo1 should be applied, false if the next one of algo2
+ */
+bool QDDVer::nextIsAlgo1(Equivalence::Strategy strategy, bool lastWasAlgo1) {
+    if(iterator1 == qc1->end()) return false;
+    if(iterator2 == qc2->end()) return true;
+
+    switch(strategy) {
+        case Equivalence::Strategy::Naive:
+            return true;
+        case Equivalence::Strategy::OneToOne:
+            return !lastWasAlgo1;
+        case Equivalence::Strategy::Proportional:   //position1 / nops1 <= position2 / nops2
+            return (unsigned long long)position1 * qc2->getNops() <= (unsigned long long)position2 * qc1->getNops();
+        case Equivalence::Strategy::Lookahead:
+            break;
+    }
+
+    //retrieving the DD of a SWAP updates the permutation, so it can't be tried without applying it
+    const auto changesPermutation = [](const std::unique_ptr<qc::Operation>& op) {
+        return op->getType() == qc::SWAP || op->getType() == qc::Compound;
+    };
+    if(changesPermutation(*iterator1)) return true;
+    if(changesPermutation(*iterator2)) return false;
+
+    //the chosen product is computed again by stepForward, which then finds it in the compute table
+    const dd::Edge left = dd->multiply(gateDD(true, false), sim);
+    const dd::Edge right = dd->multiply(sim, gateDD(false, true));
+    const unsigned int leftNodes = dd->size(left);
+    const unsigned int rightNodes = dd->size(right);
+    return leftNodes <= rightNodes;
+}
+
+/**Applies the remaining operations of algo1 from the left and the inverses of the remaining ones of algo2 from the
+ * right, in the order given by strategy, and compares the result with the identity. Both algorithms have to be loaded.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * If random stimuli are requested, both algorithms are simulated on them first (see Stimuli) and the matrices are
+ * only multiplied if all outputs agree; otherwise the state stays as it is.
+ *
+ * @param strategy decides which algorithm the next operation is taken from
+ * @param stimuli number, type and seed of the random stimuli of the pre-check (no pre-check if the number is 0)
+ * @param result is filled with the verdict, the peak number of active nodes, the number of applied operations and the
+ *          time; the active nodes are counted by the package anyway, so sampling them after every operation is free
+ * @param progress if not nullptr, processing stops early when it says so (the verdict is NoInformation then)
+ */
+void QDDVer::checkEquivalence(Equivalence::Strategy strategy, const Stimuli::Options& stimuli,
+                              Equivalence::Result& result, Progress* progress) {
+    const auto start = std::chrono::steady_clock::now();
+    result.strategy = strategy;
+    result.peakNodes = (unsigned int)dd->activeNodeCount;
+
+    if(stimuli.count > 0) {
+        result.withStimuli = true;
+        Stimuli::run(*qc1, *qc2, stimuli, result.stimuli, progress);
+        if(result.stimuli.differ)           result.verdict = Equivalence::Verdict::NotEquivalent;
+        else if(result.stimuli.cancelled)   result.cancelled = true;
+        if(result.stimuli.differ || result.stimuli.cancelled) {
+            result.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            return;
+        }
+    }
+
+    bool lastWasAlgo1 = false;
+    while(iterator1 != qc1->end() || iterator2 != qc2->end()) {
+        lastWasAlgo1 = nextIsAlgo1(strategy, lastWasAlgo1);
+        if(lastWasAlgo1)    atInitial1 = false;
+        else                atInitial2 = false;
+        stepForward(lastWasAlgo1);
+        ++result.ops;
+        result.peakNodes = std::max(result.peakNodes, (unsigned int)dd->activeNodeCount);
+
+        if(progress != nullptr && progress->step(position1 + position2, *dd, sim)) {
+            result.cancelled = true;
+            break;
+        }
+    }
+    atEnd1 = (iterator1 == qc1->end());
+    atEnd2 = (iterator2 == qc2->end());
+    gc.endOfBatch(*dd);
+
+    if(!result.cancelled) result.verdict = identity.compare(sim);
+    result.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**Checks the parameters of CheckEquivalence and CheckEquivalenceAsync and throws an error if they are invalid.
+ *
+ * @param info the parameters of the call
+ * @param strategy is set to the given strategy or Proportional if none is given
+ * @return true if the parameters are valid, false otherwise
+ */
+bool QDDVer::checkStrategyArgument(const Napi::CallbackInfo& info, Equivalence::Strategy& strategy) {
+    strategy = Equivalence::Strategy::Proportional;
+    if(info.Length() < 1 || info[0].IsUndefined()) return true;
+    if(!info[0].IsString()) {
+        Napi::TypeError::New(info.Env(), "arg1: String expected!").ThrowAsJavaScriptException();
+        return false;
+    }
+    if(!Equivalence::parseStrategy(info[0].As<Napi::String>().Utf8Value(), strategy)) {
+        Napi::Error::New(info.Env(), "Invalid strategy!").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+/**Runs both algorithms to their end and checks whether they are equivalent (see checkEquivalence).
+ *
+ * @param info takes two optional parameters
+ *              string: the strategy, "naive", "oneToOne", "proportional" (default) or "lookahead"
+ *              object: options of the pre-check with random stimuli (see Stimuli)
+ * @return object as described in Equivalence::toObject
+ */
+Napi::Value QDDVer::CheckEquivalence(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    Equivalence::Strategy strategy;
+    Stimuli::Options stimuli;
+    if(!checkStrategyArgument(info, strategy) || !Stimuli::parseOptions(env, info[1], stimuli)) return env.Undefined();
+    if(!ready1 || !ready2) {
+        Napi::Error::New(env, "Both algorithms have to be loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Equivalence::Result result{};
+    try {
+        checkEquivalence(strategy, stimuli, result);
+    } catch(std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return Equivalence::toObject(env, result);
+}
+
+/**Same as CheckEquivalence, but the operations are applied on a worker thread.
+ *
+ * @param info takes up to two parameters: the strategy as for CheckEquivalence and an optional options object
+ *              {progress: function, timeout: ms} that may also contain the options of the pre-check (see Stimuli)
+ * @return a Promise that resolves to the object returned by CheckEquivalence
+ */
+Napi::Value QDDVer::CheckEquivalenceAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Equivalence::Strategy strategy;
+    Stimuli::Options stimuli;
+    if(!checkStrategyArgument(info, strategy) || !Stimuli::parseOptions(env, info[1], stimuli)) return env.Undefined();
+
+    auto result = std::make_shared<Equivalence::Result>();
+    auto progress = std::make_shared<Progress>(env, info[1], cancelRequests);
+    return AsyncTask::start(info, busy,
+            [this, strategy, stimuli, result, progress]() {
+                if(!ready1 || !ready2) throw std::runtime_error("Both algorithms have to be loaded!");
+                checkEquivalence(strategy, stimuli, *result, progress.get());
+            },
+            [result](Napi::Env env) {
+                return Equivalence::toObject(env, *result);
+            });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Searches an input and output for which sim differs from the identity (see Counterexample) and the operation that
+ * made it diverge. The state is the same as before afterwards.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param result is filled with the counterexample, found stays false if sim is the identity (up to a global phase)
+ */
+void QDDVer::findCounterexample(Counterexample::Result& result) {
+    if(sim.p == nullptr || identity.empty() || !Counterexample::find(sim, identity.get(), result)) return;
+    findDivergence(result);
+    gc.endOfBatch(*dd);
+}
+
+/**Searches the operation after which the verification left the identity for good. The checkpoints on a chain to the
+ * current position (see CheckpointGrid::chainTo) are scanned for the last one that is still the identity, which only
+ * takes a pointer comparison per checkpoint. Then the operations between it and the next checkpoint of the chain are
+ * applied again, one at a time, and the iterators are moved back afterwards.
+ * Within this segment sim can leave the identity and come back to it (whenever the prefixes of both algorithms match
+ * again), so the whole segment is replayed and the operation right after the last point at which sim is the identity
+ * is blamed, since the identity is never regained from there on.
+ *
+ * @param result position1, position2, algo1 and operation are set if the operation was found
+ */
+void QDDVer::findDivergence(Counterexample::Result& result) {
+    const CheckpointGrid::Position current{position1, position2};
+    const std::vector<CheckpointGrid::Position> chain = checkpoints.chainTo(current);
+
+    std::size_t last = chain.size();    //index of the last checkpoint of the chain that is the identity
+    for(std::size_t i = chain.size(); i-- > 0;) {
+        if(identity.compare(checkpoints.at(chain[i])->state) != Equivalence::Verdict::NotEquivalent) {
+            last = i;
+            break;
+        }
+    }
+    if(last == chain.size()) return;    //no checkpoint on the way is the identity
+    const CheckpointGrid::Position from = chain[last];
+    const CheckpointGrid::Position to = last + 1 < chain.size() ? chain[last + 1] : current;
+    if(from == to) return;
+
+    restoreCheckpoint(from, *checkpoints.at(from));
+    atInitial1 = false;
+    atInitial2 = false;
+    atEnd1 = false;
+    atEnd2 = false;
+    //both algorithms progress proportionally, like the Proportional strategy of checkEquivalence
+    bool left = false;      //whether sim left the identity since it was the identity the last time
+    while(position1 < to.first || position2 < to.second) {
+        const unsigned long long done1 = (unsigned long long)(position1 - from.first) * (to.second - from.second);
+        const unsigned long long done2 = (unsigned long long)(position2 - from.second) * (to.first - from.first);
+        const bool algo1 = position2 >= to.second || (position1 < to.first && done1 <= done2);
+        stepForward(algo1);
+        if(identity.compare(sim) != Equivalence::Verdict::NotEquivalent) {
+            left = false;
+        } else if(!left) {  //the first operation after the identity, blamed unless the identity comes back
+            left = true;
+            result.position1 = position1;
+            result.position2 = position2;
+            result.algo1 = algo1;
+            result.operation = (algo1 ? position1 : position2) - 1;
+        }
+    }
+    if(!left) result.operation = -1;    //sim is the identity again at the end of the segment
+
+    StepResult back;
+    moveTo(current.first, current.second, back);
+}
+
+/**
+ *
+ * @param info has no parameters
+ * @return object as described in Counterexample::toObject
+ */
+Napi::Value QDDVer::FindCounterexample(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready1 || !ready2) {
+        Napi::Error::New(env, "Both algorithms have to be loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Counterexample::Result result{};
+    findCounterexample(result);
+    return Counterexample::toObject(env, result);
+}
+
+/**Same as FindCounterexample, but the search runs on a worker thread.
+ *
+ * @param info has no parameters
+ * @return a Promise that resolves to the object returned by FindCounterexample
+ */
+Napi::Value QDDVer::FindCounterexampleAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<Counterexample::Result>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready1 || !ready2) throw std::runtime_error("Both algorithms have to be loaded!");
+                findCounterexample(*result);
+            },
+            [result](Napi::Env env) { return Counterexample::toObject(env, *result); });
 }
 
 Napi::Value QDDVer::ConductIrreversibleOperation(const Napi::CallbackInfo& info) {
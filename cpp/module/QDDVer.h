@@ -6,6 +6,7 @@
 #define QDD_VIS_QDDVER_H
 
 #include <napi.h>
+#include <atomic>
 #include <string>
 
 #include "operations/Operation.hpp"
@@ -13,18 +14,70 @@
 #include "DDcomplex.h"
 #include "DDpackage.h"
 
+#include "Progress.h"
+#include "CheckpointGrid.h"
+#include "GateCache.h"
+#include "GCPolicy.h"
+#include "DDSerializer.h"
+#include "DDDiff.h"
+#include "ExportCache.h"
+#include "Layout.h"
+#include "LevelOfDetail.h"
+#include "PackagePool.h"
+#include "MemoryUsage.h"
+#include "CircuitCache.h"
+#include "Equivalence.h"
+#include "Identity.h"
+#include "Counterexample.h"
+
 class QDDVer : public Napi::ObjectWrap<QDDVer> {
 public:
     static Napi::Object Init(Napi::Env env, Napi::Object exports);
     explicit QDDVer(const Napi::CallbackInfo& info);
+    ~QDDVer() override;
 
 private:
     static Napi::FunctionReference constructor;
 
+    struct StepResult {     //plain result of a call, converted to a JS object on the main thread
+        long long numOfOperations = -1;
+        bool changed = false;
+        bool cancelled = false;     //true if an asynchronous call stopped early (cancel() or timeout)
+        Equivalence::Verdict verdict = Equivalence::Verdict::NotYet;    //structural check of sim after the call
+        unsigned int nonIdentityNodes = 0;  //number of nodes of sim that are not part of the identity
+    };
+
     //"private" methods
+    void releasePackage();
+    MemoryUsage measureMemory();
     void stepForward(bool algo1);   //whether it is applied on algo1 or algo2
     void stepBack(bool algo1);      //whether it is applied on algo1 or algo2
     void stepToStart(bool algo1);   //whether it is applied on algo1 or algo2
+    void moveTo(unsigned int target1, unsigned int target2, StepResult& result, Progress* progress = nullptr);
+    void restoreCheckpoint(const CheckpointGrid::Position& position, const CheckpointGrid::Checkpoint& cp);
+    dd::Edge gateDD(bool algo1, bool inverse);
+    bool isLoaded(bool algo1) const;
+    dd::Edge initialMatrix(const CircuitCache::Circuit& circuit);
+    bool nextIsAlgo1(Equivalence::Strategy strategy, bool lastWasAlgo1);
+    void checkEquivalence(Equivalence::Strategy strategy, const Stimuli::Options& stimuli, Equivalence::Result& result,
+                          Progress* progress = nullptr);
+    void inspect(StepResult& result);
+    static void setInspection(Napi::Env env, Napi::Object& state, const StepResult& result);
+    static Napi::Object stepState(Napi::Env env, const StepResult& result);
+    static bool checkAlgoArgument(const Napi::CallbackInfo& info, bool& algo1);
+    void findCounterexample(Counterexample::Result& result);
+    void findDivergence(Counterexample::Result& result);
+    static bool checkStrategyArgument(const Napi::CallbackInfo& info, Equivalence::Strategy& strategy);
+    bool checkLoadArguments(const Napi::CallbackInfo& info);
+    void load(const std::string& algo, unsigned int formatCode, unsigned int opNum, bool process, bool algo1, StepResult& result,
+              Progress* progress = nullptr);
+    void toStart(bool algo1, StepResult& result);
+    void prev(bool algo1, StepResult& result);
+    void next(bool algo1, StepResult& result);
+    void toEnd(bool algo1, StepResult& result, Progress* progress = nullptr);
+    void toLine(unsigned int targetPos, bool algo1, StepResult& result, Progress* progress = nullptr);
+    ExportCache::Dot exportDD();
+    ExportCache::Binary exportBinary();
     //std::pair<fp, fp> getProbabilities(unsigned short qubitIdx);
     //void measureQubit(unsigned short qubitIdx, bool measureOne, fp pzero, fp pone);
 
@@ -41,10 +94,37 @@ private:
     Napi::Value IsReady(const Napi::CallbackInfo& info);
     void Unready(const Napi::CallbackInfo& info);
     Napi::Value ConductIrreversibleOperation(const Napi::CallbackInfo& info);
+    //Promise-returning variants that do the work on the worker pool of the Scheduler
+    Napi::Value LoadAsync(const Napi::CallbackInfo& info);
+    Napi::Value ToStartAsync(const Napi::CallbackInfo& info);
+    Napi::Value PrevAsync(const Napi::CallbackInfo& info);
+    Napi::Value NextAsync(const Napi::CallbackInfo& info);
+    Napi::Value ToEndAsync(const Napi::CallbackInfo& info);
+    Napi::Value ToLineAsync(const Napi::CallbackInfo& info);
+    Napi::Value GetDDAsync(const Napi::CallbackInfo& info);
+    Napi::Value GetDDBinary(const Napi::CallbackInfo& info);
+    Napi::Value GetDDBinaryAsync(const Napi::CallbackInfo& info);
+    Napi::Value GetDDDiff(const Napi::CallbackInfo& info);
+    Napi::Value GetDDDiffAsync(const Napi::CallbackInfo& info);
+    Napi::Value GetLayout(const Napi::CallbackInfo& info);
+    Napi::Value GetLayoutAsync(const Napi::CallbackInfo& info);
+    Napi::Value GetDDSummary(const Napi::CallbackInfo& info);
+    Napi::Value GetDDSummaryAsync(const Napi::CallbackInfo& info);
+    void Cancel(const Napi::CallbackInfo& info);
+    Napi::Value GetStats(const Napi::CallbackInfo& info);
+    void SetGCPolicy(const Napi::CallbackInfo& info);
+    void Release(const Napi::CallbackInfo& info);
+    Napi::Value CheckEquivalence(const Napi::CallbackInfo& info);
+    Napi::Value CheckEquivalenceAsync(const Napi::CallbackInfo& info);
+    Napi::Value FindCounterexample(const Napi::CallbackInfo& info);
+    Napi::Value FindCounterexampleAsync(const Napi::CallbackInfo& info);
+    Napi::Value GetMemoryUsage(const Napi::CallbackInfo& info);
+    Napi::Value Compact(const Napi::CallbackInfo& info);
 
     //fields
-    std::unique_ptr<dd::Package> dd;
+    std::unique_ptr<dd::Package> dd;   //nullptr until the first load and after the package was released
     dd::Edge sim{};
+    Identity identity{};    //the DD sim started with, the algorithms are equivalent if sim ends up being it again
     std::array<short, qc::MAX_QUBITS> line {};
 
     //options for the DD export
@@ -52,19 +132,32 @@ private:
     bool showEdgeLabels = false;
     bool showClassic = false;
 
-    std::unique_ptr<qc::QuantumComputation> qc1;
+    GCPolicy gc{};      //when the garbage collection runs while stepping
+    DDDiff ddDiff{};    //the last DD exported via GetDDDiff
+    ExportCache exports{};  //serialized forms of the last exported states
+    Layout graphLayout{};   //positions of the last laid out DD
+    LevelOfDetail levelOfDetail{};  //ids and probabilities of the nodes of the last summarized DD
+    MemoryUsage memory{};   //last measured memory usage, reported while an asynchronous call is busy
+    CheckpointGrid checkpoints{};   //sparse snapshots of sim for random access to any pair of positions
+
+    std::atomic<bool> busy{false};  //true while an asynchronous call is working on this object
+    std::atomic<unsigned int> cancelRequests{0};  //counted by Cancel, stops the asynchronous calls submitted before
+
+    CircuitCache::Circuit qc1;  //shared with all sessions that loaded the same algorithm, hence never modified
     qc::permutationMap map1;
-    std::vector<std::unique_ptr<qc::Operation>>::iterator iterator1{};  //operations of algo1
+    GateCache gates1{};  //DDs of the operations of algo1
+    std::vector<std::unique_ptr<qc::Operation>>::const_iterator iterator1{};  //operations of algo1
     unsigned int position1 = 0;  //current position of iterator1
 
     bool ready1 = false;     //true if algo1 is valid
     bool atInitial1 = true;  //whether we're currently before the first operation of algo1
     bool atEnd1 = false;     //whether we're currently after the last operation of algo1
 
-    std::unique_ptr<qc::QuantumComputation> qc2;
+    CircuitCache::Circuit qc2;  //shared with all sessions that loaded the same algorithm, hence never modified
     qc::permutationMap map2;
-    std::vector<std::unique_ptr<qc::Operation>>::iterator iterator2{};  //operations of algo2
+    std::vector<std::unique_ptr<qc::Operation>>::const_iterator iterator2{};  //operations of algo2
     //permutationMap2
+    GateCache gates2{};  //DDs of the operations of algo2
     unsigned int position2 = 0;  //current position of iterator2
 
     bool ready2 = false;     //true if algo2 is valid
@@ -2,6 +2,9 @@
 #include <iostream>
 #include <string>
 #include <memory>
+#include <stdexcept>
+#include <random>
+#include <algorithm>
 
 #include "operations/StandardOperation.hpp"
 #include "QuantumComputation.hpp"
@@ -10,6 +13,9 @@
 #include "DDpackage.h"
 
 #include "QDDVis.h"
+#include "CircuitDiff.h"
+#include "AsyncTask.h"
+#include "Scheduler.h"
 
 Napi::FunctionReference QDDVis::constructor;
 
@@ -31,7 +37,37 @@ Napi::Object QDDVis::Init(Napi::Env env, Napi::Object exports) {
                             InstanceMethod("getExportOptions", &QDDVis::GetExportOptions),
                             InstanceMethod("isReady", &QDDVis::IsReady),
                             InstanceMethod("unready", &QDDVis::Unready),
-                            InstanceMethod("conductIrreversibleOperation", &QDDVis::ConductIrreversibleOperation)
+                            InstanceMethod("conductIrreversibleOperation", &QDDVis::ConductIrreversibleOperation),
+                            InstanceMethod("loadAsync", &QDDVis::LoadAsync),
+                            InstanceMethod("toStartAsync", &QDDVis::ToStartAsync),
+                            InstanceMethod("prevAsync", &QDDVis::PrevAsync),
+                            InstanceMethod("nextAsync", &QDDVis::NextAsync),
+                            InstanceMethod("toEndAsync", &QDDVis::ToEndAsync),
+                            InstanceMethod("toLineAsync", &QDDVis::ToLineAsync),
+                            InstanceMethod("getDDAsync", &QDDVis::GetDDAsync),
+                            InstanceMethod("getDDBinary", &QDDVis::GetDDBinary),
+                            InstanceMethod("getDDBinaryAsync", &QDDVis::GetDDBinaryAsync),
+                            InstanceMethod("getDDDiff", &QDDVis::GetDDDiff),
+                            InstanceMethod("getDDDiffAsync", &QDDVis::GetDDDiffAsync),
+                            InstanceMethod("getLayout", &QDDVis::GetLayout),
+                            InstanceMethod("getLayoutAsync", &QDDVis::GetLayoutAsync),
+                            InstanceMethod("getDDSummary", &QDDVis::GetDDSummary),
+                            InstanceMethod("getDDSummaryAsync", &QDDVis::GetDDSummaryAsync),
+                            InstanceMethod("getSubDD", &QDDVis::GetSubDD),
+                            InstanceMethod("getSubDDAsync", &QDDVis::GetSubDDAsync),
+                            InstanceMethod("cancel", &QDDVis::Cancel),
+                            InstanceMethod("getStats", &QDDVis::GetStats),
+                            InstanceMethod("setGCPolicy", &QDDVis::SetGCPolicy),
+                            InstanceMethod("getProbabilities", &QDDVis::GetProbabilities),
+                            InstanceMethod("sample", &QDDVis::Sample),
+                            InstanceMethod("sampleAsync", &QDDVis::SampleAsync),
+                            InstanceMethod("measureRegister", &QDDVis::MeasureRegister),
+                            InstanceMethod("measureRegisterAsync", &QDDVis::MeasureRegisterAsync),
+                            InstanceMethod("getStateVector", &QDDVis::GetStateVector),
+                            InstanceMethod("getStateVectorAsync", &QDDVis::GetStateVectorAsync),
+                            InstanceMethod("release", &QDDVis::Release),
+                            InstanceMethod("memoryUsage", &QDDVis::GetMemoryUsage),
+                            InstanceMethod("compact", &QDDVis::Compact)
                         }
                     );
 
@@ -52,9 +88,7 @@ QDDVis::QDDVis(const Napi::CallbackInfo& info) : Napi::ObjectWrap<QDDVis>(info)
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
-    this->dd = std::make_unique<dd::Package>();
-    this->qc = std::make_unique<qc::QuantumComputation>();
-	dd->setMode(dd::Vector);
+    this->qc = CircuitCache::empty();   //the package is only acquired on the first load
 
     line.fill(qc::LINE_DEFAULT);
     this->iterator = this->qc->begin();
@@ -67,6 +101,7 @@ QDDVis::QDDVis(const Napi::CallbackInfo& info) : Napi::ObjectWrap<QDDVis>(info)
  */
 void QDDVis::stepForward() {
     if(atEnd) return;   //no further steps possible
+    const bool irreversible = (*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset;
 	dd::Edge currDD{};
     if ((*iterator)->isClassicControlledOperation()) {
     	auto startIndex = (unsigned short)((*iterator)->getParameter().at(0));
@@ -79,25 +114,28 @@ void QDDVis::stepForward() {
 	    }
 
 	    if (value == expectedValue) {
-		    currDD = (*iterator)->getDD(dd, line);    //retrieve the "new" current operation
+		    currDD = gateDD(false);    //retrieve the "new" current operation
 	    } else {
 	    	currDD = dd->makeIdent(0, qc->getNqubits()-1);
 	    }
     } else {
-	    currDD = (*iterator)->getDD(dd, line);    //retrieve the "new" current operation
+	    currDD = gateDD(false);    //retrieve the "new" current operation
     }
 
     auto temp = dd->multiply(currDD, sim);         //process the current operation by multiplying it with the previous simulation-state
     dd->incRef(temp);
     dd->decRef(sim);
     sim = temp;
-    dd->garbageCollect();
+    gc.afterStep(*dd);
 
     iterator++; // advance iterator
     position++;
     if (iterator == qc->end()) {    //qc1->end() is after the last operation in the iterator
         atEnd = true;
     }
+    //an irreversible operation can only be passed backwards by restoring a checkpoint after it
+    if (irreversible) checkpoints.record(*dd, position, sim, measurements, true);
+    else              checkpoints.offer(*dd, position, sim, measurements);
 }
 
 /**If either atInitial is true or the iterator is at the beginning, this method does nothing. In other cases it will
@@ -128,75 +166,89 @@ void QDDVis::stepBack() {
 		}
 
 		if (value == expectedValue) {
-			currDD = (*iterator)->getInverseDD(dd, line); // get the inverse of the current operation
+			currDD = gateDD(true); // get the inverse of the current operation
 		} else {
 			currDD = dd->makeIdent(0, qc->getNqubits()-1);
 		}
 	} else {
-		currDD = (*iterator)->getInverseDD(dd, line); // get the inverse of the current operation
+		currDD = gateDD(true); // get the inverse of the current operation
 	}
 
     auto temp = dd->multiply(currDD, sim);   //"remove" the current operation by multiplying with its inverse
     dd->incRef(temp);
     dd->decRef(sim);
     sim = temp;
-    dd->garbageCollect();
+    gc.afterStep(*dd);
 }
 
-std::pair<fp, fp> QDDVis::getProbabilities(unsigned short qubitIdx) {
-	std::map<dd::NodePtr, fp> probsMone;
-	std::set<dd::NodePtr> visited_nodes2;
-	std::queue<dd::NodePtr> q;
-
-	probsMone[sim.p] = CN::mag2(sim.w);
-	visited_nodes2.insert(sim.p);
-	q.push(sim.p);
-
-	while(q.front()->v != qubitIdx) {
-		dd::NodePtr ptr = q.front();
-		q.pop();
-		fp prob = probsMone[ptr];
-
-		if(!CN::equalsZero(ptr->e[0].w)) {
-			const fp tmp1 = prob * CN::mag2(ptr->e[0].w);
-
-			if(visited_nodes2.find(ptr->e[0].p) != visited_nodes2.end()) {
-				probsMone[ptr->e[0].p] = probsMone[ptr->e[0].p] + tmp1;
-			} else {
-				probsMone[ptr->e[0].p] = tmp1;
-				visited_nodes2.insert(ptr->e[0].p);
-				q.push(ptr->e[0].p);
-			}
-		}
+/**Returns the DD of the operation the iterator is pointing at, preferably from the gate cache.
+ *
+ * @param inverse whether the inverse DD of the operation is needed
+ * @return the (inverse) DD of the current operation
+ */
+dd::Edge QDDVis::gateDD(bool inverse) {
+	dd::Edge gate{};
+	if (gates.lookup(position, inverse, gate)) return gate;
 
-		if(!CN::equalsZero(ptr->e[2].w)) {
-			const fp tmp1 = prob * CN::mag2(ptr->e[2].w);
+	gate = inverse ? (*iterator)->getInverseDD(dd, line) : (*iterator)->getDD(dd, line);
+	gates.store(*dd, position, inverse, gate);
+	return gate;
+}
 
-			if(visited_nodes2.find(ptr->e[2].p) != visited_nodes2.end()) {
-				probsMone[ptr->e[2].p] = probsMone[ptr->e[2].p] + tmp1;
-			} else {
-				probsMone[ptr->e[2].p] = tmp1;
-				visited_nodes2.insert(ptr->e[2].p);
-				q.push(ptr->e[2].p);
-			}
-		}
+/**Restores the nearest checkpoint at or before targetPos and replays the remaining operations until targetPos is
+ * reached. A pinned checkpoint is recorded right after every measurement or reset that is passed, but if there is none
+ * (e.g. the algorithm was edited), an irreversible operation may lie between the checkpoint and targetPos. Its outcome
+ * can't be replayed, so nothing is changed then.
+ *
+ * @param targetPos the position the simulation should be at after this call
+ * @return true if the simulation is at targetPos now, false if targetPos can't be reached (the state is unchanged)
+ */
+bool QDDVis::restoreCheckpoint(unsigned int targetPos) {
+	unsigned int checkpointPos = 0;
+	const Checkpoints::Checkpoint* cp = checkpoints.nearest(targetPos, checkpointPos);
+	if (cp == nullptr) {    //the start is always available, so we just add it again
+		checkpoints.record(*dd, 0, dd->makeZeroState(qc->getNqubits()), std::bitset<qc::MAX_QUBITS>{}, true);
+		cp = checkpoints.nearest(targetPos, checkpointPos);
 	}
+	if (irreversibleBetween(checkpointPos, targetPos)) return false;
 
-	fp pzero{0}, pone{0};
-	while(!q.empty()) {
-		dd::NodePtr ptr = q.front();
-		q.pop();
+	dd::Edge restored = cp->state;
+	dd->incRef(restored);
+	dd->decRef(sim);
+	sim = restored;
+	measurements = cp->measurements;
 
-		if(!CN::equalsZero(ptr->e[0].w)) {
-			pzero += probsMone[ptr] * CN::mag2(ptr->e[0].w);
-		}
+	iterator = qc->begin() + checkpointPos;
+	position = checkpointPos;
+	atEnd = (iterator == qc->end());
 
-		if(!CN::equalsZero(ptr->e[2].w)) {
-			pone += probsMone[ptr] * CN::mag2(ptr->e[2].w);
-		}
+	while (position < targetPos && !atEnd) stepForward();
+	atInitial = (position == 0);
+	return true;
+}
+
+/**
+ *
+ * @param from index of the first operation to check
+ * @param to index after the last operation to check
+ * @return true if a measurement or reset lies within [from, to), false otherwise
+ */
+bool QDDVis::irreversibleBetween(unsigned int from, unsigned int to) {
+	for (auto it = qc->begin() + from; it != qc->end() && from < to; ++it, ++from) {
+		if ((*it)->getType() == qc::Measure || (*it)->getType() == qc::Reset) return true;
 	}
+	return false;
+}
 
-	return {pzero, pone};
+/**
+ *
+ * @param qubitIdx the qubit we want to know the probabilities of
+ * @return (P(0), P(1)) of the given qubit in the current state (all qubits are computed in one pass and remembered)
+ */
+std::pair<fp, fp> QDDVis::getProbabilities(unsigned short qubitIdx) {
+	const auto& probabilities = marginals.get(*dd, sim);
+	if (qubitIdx >= probabilities.size()) return {1, 0};    //qubit is not part of the DD, so it's still |0>
+	return probabilities[qubitIdx];
 }
 
 void QDDVis::measureQubit(unsigned short qubitIdx, bool measureOne, fp pzero, fp pone) {
@@ -228,81 +280,197 @@ void QDDVis::measureQubit(unsigned short qubitIdx, bool measureOne, fp pzero, fp
 	sim = e;
 }
 
+/**Steps over the measurement or reset the iterator points at and conducts it for all of its qubits at once. The
+ * outcome of each qubit is either taken from outcomes or drawn with a random generator seeded by seed.
+ * If one of the given outcomes is impossible, the state is restored and nothing changes.
+ *
+ * @param outcomes outcome per qubit of the operation ('0' or '1'), or nullptr to draw them
+ * @param seed seed of the random generator if the outcomes are drawn
+ * @return outcome and probabilities per qubit in the order of the operation's qubits
+ * @throws std::invalid_argument if the iterator doesn't point at a measurement or reset, the number of outcomes doesn't
+ *          match or an outcome is impossible
+ */
+std::vector<QDDVis::Measurement> QDDVis::measureRegister(const std::string* outcomes, unsigned long long seed) {
+	if (atEnd || ((*iterator)->getType() != qc::Measure && (*iterator)->getType() != qc::Reset)) {
+		throw std::invalid_argument("The next operation is neither a measurement nor a reset!");
+	}
+	const bool isReset = (*iterator)->getType() == qc::Reset;
+
+	std::vector<Measurement> results;
+	if (isReset) {
+		for (auto qubit : (*iterator)->getTargets()) results.push_back(Measurement{(unsigned short)qubit, -1, 0, 0, '0'});
+	} else {
+		const auto& cbits = (*iterator)->getTargets();
+		const auto& qubits = (*iterator)->getControls();
+		for (std::size_t i = 0; i < qubits.size(); i++) {
+			results.push_back(Measurement{(unsigned short)qubits[i].qubit, (long)cbits.at(i), 0, 0, '0'});
+		}
+	}
+	if (outcomes != nullptr && outcomes->size() != results.size()) {
+		throw std::invalid_argument("Expected " + std::to_string(results.size()) + " outcomes!");
+	}
+
+	//keep the state, so we can restore it if an outcome turns out to be impossible
+	dd::Edge before = sim;
+	dd->incRef(before);
+	const auto measurementsBefore = measurements;
+
+	std::mt19937_64 rng(seed);
+	std::uniform_real_distribution<fp> dist(0.0, 1.0);
+	try {
+		for (std::size_t i = 0; i < results.size(); i++) {
+			Measurement& m = results[i];
+			std::tie(m.pzero, m.pone) = getProbabilities(m.qubit);
+			if (outcomes != nullptr) m.outcome = (*outcomes)[i];
+			else                     m.outcome = dist(rng) < m.pzero / (m.pzero + m.pone) ? '0' : '1';
+
+			const bool measureOne = m.outcome == '1';
+			if ((measureOne ? m.pone : m.pzero) < 1e-13) {
+				throw std::invalid_argument(std::string("Outcome ") + m.outcome + " of qubit " + std::to_string(m.qubit) + " is impossible!");
+			}
+			measureQubit(m.qubit, measureOne, m.pzero, m.pone);
+			if (isReset && measureOne) {    //apply x operation to reset to |0>
+				auto tmp = dd->multiply(qc::StandardOperation(qc->getNqubits(), m.qubit, qc::X).getDD(dd, line), sim);
+				dd->incRef(tmp);
+				dd->decRef(sim);
+				sim = tmp;
+				gc.afterStep(*dd);
+			}
+			if (!isReset) measurements.set(m.cbit, measureOne);
+		}
+	} catch (std::exception&) {
+		dd->decRef(sim);
+		sim = before;   //still ref-counted from above
+		measurements = measurementsBefore;
+		throw;
+	}
+	dd->decRef(before);
+
+	atInitial = false;
+	iterator++;
+	position++;
+	if (iterator == qc->end()) atEnd = true;
+	//the outcomes can't be recomputed, so this checkpoint is the only way to go back over the operation later
+	checkpoints.dropFrom(*dd, position);
+	checkpoints.record(*dd, position, sim, measurements, true);
+	gc.endOfBatch(*dd);
+	return results;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/**Parameters: String algorithm, unsigned int formatCode, unsigned int num of operations to step forward, bool whether the
- * operations should be processed or just the iterator needs to be advanced
- * Returns: true or false 
- * 
- * Tries to import the passed algorithm and returns whether it was successful or not. Additionally some operations/DDs can
- * be applied or just the iterator advance forward without applying operations/DDs.
+/**Checks the parameters of Load and LoadAsync and throws an error if they are invalid.
+ *
+ * @param info the parameters of the call
+ * @return true if the parameters are valid, false otherwise
  */
-Napi::Value QDDVis::Load(const Napi::CallbackInfo& info) {
+bool QDDVis::checkLoadArguments(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    Napi::Object state = Napi::Object::New(env);
-    state.Set("numOfOperations", Napi::Number::New(env, -1));
-    state.Set("nextIsIrreversible", Napi::Boolean::New(env, false));
-    state.Set("noGoingBack", Napi::Boolean::New(env, false));
-
     //check if the correct parameters have been passed
     if(info.Length() < 4) {
         Napi::RangeError::New(env, "Need 4 (String, unsigned int, unsigned int, bool) arguments!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[0].IsString()) {  //algorithm
         Napi::TypeError::New(env, "arg1: String expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[1].IsNumber()) {  //format code (1 = QASM, 2 = Real)
         Napi::TypeError::New(env, "arg3: unsigned int expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[2].IsNumber()) {  //number of operations to immediately process
         Napi::TypeError::New(env, "arg2: unsigned int expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
     if (!info[3].IsBoolean()) { //whether operations should be processed while advancing the iterator to opNum or not (true = new simulation; false = continue simulation)
         Napi::TypeError::New(env, "arg3: boolean expected!").ThrowAsJavaScriptException();
-        return state;
+        return false;
     }
+    return true;
+}
 
-    //the first parameter (algorithm)
-    Napi::String arg = info[0].As<Napi::String>();
-    const std::string algo = arg.Utf8Value();
-    std::stringstream ss{algo};
-
+/**Imports the given algorithm and applies opNum operations or just advances the iterator by opNum operations.
+ * If the new algorithm is an edited version of the loaded one, the operations before the first edited one aren't
+ * simulated again: the current state is only taken back to that operation (or opNum, if it is smaller) and the
+ * remaining operations up to opNum are applied. The simulation starts from scratch instead if the state can't be taken
+ * back that far (no checkpoint after an irreversible operation) or a measurement or reset would have to be replayed.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param algo the algorithm to import
+ * @param formatCode format of the algorithm (1 = QASM, 2 = Real)
+ * @param opNum number of operations to step forward (may be bigger than the number of operations of the algorithm)
+ * @param process whether the operations should be processed or just the iterator needs to be advanced
+ * @param result is filled with numOfOperations, nextIsIrreversible and cancelled
+ * @param progress if not nullptr, processing stops early when it says so (the state stays at the last applied operation)
+ * @throws std::invalid_argument if the format-code or the algorithm is invalid
+ */
+void QDDVis::load(const std::string& algo, unsigned int formatCode, unsigned int opNum, bool process, StepResult& result,
+                  Progress* progress) {
+    //the format code describes the format of the algorithm
+    qc::Format format;
+    if(formatCode == 1)         format = qc::OpenQASM;
+    else if(formatCode == 2)    format = qc::Real;
+    else throw std::invalid_argument("Invalid format-code!");
+
+    CircuitCache::Circuit circuit;
     try {
-        //second parameter describes the format of the algorithm
-        const unsigned int formatCode = (unsigned int)info[1].As<Napi::Number>();
-        if(formatCode == 1)         qc->import(ss, qc::OpenQASM);
-        else if(formatCode == 2)    qc->import(ss, qc::Real);
-        else {
-            Napi::Error::New(env, "Invalid format-code!").ThrowAsJavaScriptException();
-            return state;
-        }
-
+        circuit = CircuitCache::get(algo, format);
     } catch(std::exception& e) {
         std::cout << "Exception while loading the algorithm: " << e.what() << std::endl;
         std::string err(e.what());
-        Napi::Error::New(env, "Invalid algorithm!\n" + err).ThrowAsJavaScriptException();
-        return state;
+        throw std::invalid_argument("Invalid algorithm!\n" + err);
     }
+    if(!dd) dd = PackagePool::acquire(dd::Vector);
+    if(sim.p == nullptr) process = true;    //there is no state we could continue with (e.g. the package was released)
+    if(opNum > circuit->getNops()) opNum = circuit->getNops();  //opNum may be bigger than the number of operations
+
+    //the operations before the first edited one have the same DDs and lead to the same states as before
+    const unsigned int unchanged = ready ? CircuitDiff::firstDifference(*qc, *circuit) : 0;
+    bool resimulate = process && ready && opNum > 0 && unchanged > 0;
+    if(resimulate && position > std::min(unchanged, opNum)) {
+        StepResult rewind{};
+        toLine(std::min(unchanged, opNum), rewind);     //qc is still the old algorithm, whose operations are undone
+        resimulate = position == std::min(unchanged, opNum);    //toLine stops short if it can't undo a measurement
+    }
+    gates.dropFrom(*dd, unchanged);
+    qc = circuit;
+    //stepForward doesn't know the outcomes the client chose, so only the full simulation below steps over measurements
+    if(resimulate && irreversibleBetween(position, opNum)) resimulate = false;
+    ddDiff.clear(*dd);  //the client starts with a new graph anyway
+    exports.clear(*dd);
+    graphLayout.clear(*dd);
+    levelOfDetail.clear(*dd);
 
-    //re-initialize some variables (though depending on opNum they might change in the next lines)
     ready = true;
+    result.numOfOperations = qc->getNops();
+    if(resimulate) {    //only the operations from the current position (at most unchanged) up to opNum are applied
+        checkpoints.dropFrom(*dd, unchanged + 1);
+        iterator = qc->begin() + position;
+        atEnd = (iterator == qc->end());
+        while(position < opNum) {
+            stepForward();
+            if(progress != nullptr && progress->step(position, *dd, sim)) {
+                result.cancelled = true;
+                break;
+            }
+        }
+        gc.endOfBatch(*dd);
+        atInitial = (position == 0);
+        if (iterator != qc->end() && ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset)) {
+            result.nextIsIrreversible = true;
+        }
+        return;
+    }
+
+    //re-initialize some variables (though depending on opNum they might change in the next lines)
     atInitial = true;
     atEnd = false;
     iterator = qc->begin();
     position = 0;
 
-	state.Set("numOfOperations", Napi::Number::New(env, qc->getNops()));
-
-    //the third parameter (how many operations to apply immediately)
-    unsigned int opNum = (unsigned int)info[2].As<Napi::Number>();    //at this point opNum may be bigger than the number of operations the algorithm has!
-    if(opNum > qc->getNops()) opNum = qc->getNops();
     if(opNum > 0) {
         atInitial = false;
-        const bool process = (bool)info[3].As<Napi::Boolean>(); //the fourth parameter tells us to process iterated operations or not
         if(process) {
             if(sim.p != nullptr) {
                 dd->decRef(sim);
@@ -310,26 +478,28 @@ Napi::Value QDDVis::Load(const Napi::CallbackInfo& info) {
             }
             sim = dd->makeZeroState(qc->getNqubits());
             dd->incRef(sim);
+            measurements.reset();
+            checkpoints.clear(*dd);
+            checkpoints.record(*dd, 0, sim, measurements, true);
 
             for(unsigned int i = 0; i < opNum; i++) {    //apply some operations
                 stepForward();
+                if(progress != nullptr && progress->step(position, *dd, sim)) {
+                    result.cancelled = true;
+                    break;
+                }
             }
+            gc.endOfBatch(*dd);
         } else {
             for(unsigned int i = 0; i < opNum; i++) {
                 iterator++; //just advance the iterator so it points to the operations where we stopped before the edit
                 position++;
             }
+            checkpoints.dropFrom(*dd, opNum + 1);   //only the operations after opNum might have been edited
+        }
+        if (iterator != qc->end() && ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset)) {
+            result.nextIsIrreversible = true;
         }
-	    if (iterator != qc->end() && ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset)) {
-		    state.Set("nextIsIrreversible", Napi::Boolean::New(env, true));
-	    }
-	    if (iterator != qc->begin()) {
-		    auto testForMeasureIt = iterator;
-		    --testForMeasureIt;
-		    if ((*testForMeasureIt)->getType() == qc::Measure || (*testForMeasureIt)->getType() == qc::Reset) {
-			    state.Set("noGoingBack", Napi::Boolean::New(env, true));
-		    }
-	    }
 
     } else {    //sim needs to be initialized in some cases
         if(sim.p != nullptr) {
@@ -338,105 +508,282 @@ Napi::Value QDDVis::Load(const Napi::CallbackInfo& info) {
         }
         sim = dd->makeZeroState(qc->getNqubits());
         dd->incRef(sim);
+        measurements.reset();
+        checkpoints.clear(*dd);
+        checkpoints.record(*dd, 0, sim, measurements, true);
     }
+}
+
+Napi::Object QDDVis::loadState(Napi::Env env, const StepResult& result) {
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("numOfOperations", Napi::Number::New(env, result.numOfOperations));
+    state.Set("nextIsIrreversible", Napi::Boolean::New(env, result.nextIsIrreversible));
+    state.Set("noGoingBack", Napi::Boolean::New(env, result.noGoingBack));
+    state.Set("cancelled", Napi::Boolean::New(env, result.cancelled));
     return state;
 }
 
+/**Parameters: String algorithm, unsigned int formatCode, unsigned int num of operations to step forward, bool whether the
+ * operations should be processed or just the iterator needs to be advanced
+ * Returns: object with members numOfOperations (-1 on error), nextIsIrreversible, noGoingBack
+ * 
+ * Tries to import the passed algorithm and returns whether it was successful or not. Additionally some operations/DDs can
+ * be applied or just the iterator advance forward without applying operations/DDs.
+ */
+Napi::Value QDDVis::Load(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    StepResult result;
+    if(AsyncTask::isBusy(env, busy) || !checkLoadArguments(info)) return loadState(env, result);
+
+    const std::string algo = info[0].As<Napi::String>().Utf8Value();
+    const unsigned int formatCode = (unsigned int)info[1].As<Napi::Number>();
+    const unsigned int opNum = (unsigned int)info[2].As<Napi::Number>();
+    const bool process = (bool)info[3].As<Napi::Boolean>();
+
+    try {
+        load(algo, formatCode, opNum, process, result);
+    } catch(std::exception& e) {
+        result.numOfOperations = -1;
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+    }
+    return loadState(env, result);
+}
+
+/**Same as Load, but the algorithm is imported and simulated on a worker thread.
+ *
+ * @param info same parameters as Load, optionally followed by an options object (see Progress) after algo1
+ * @return a Promise that resolves to the same object as Load returns (cancelled is true if the simulation stopped
+ *          before opNum was reached) or rejects with the error Load would throw
+ */
+Napi::Value QDDVis::LoadAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(!checkLoadArguments(info)) return env.Undefined();
+
+    const std::string algo = info[0].As<Napi::String>().Utf8Value();
+    const unsigned int formatCode = (unsigned int)info[1].As<Napi::Number>();
+    const unsigned int opNum = (unsigned int)info[2].As<Napi::Number>();
+    const bool process = (bool)info[3].As<Napi::Boolean>();
+
+    auto result = std::make_shared<StepResult>();
+    auto progress = std::make_shared<Progress>(env, info[5], cancelRequests);    //info[4] is algo1 for QDDVer
+    return AsyncTask::start(info, busy,
+            [this, algo, formatCode, opNum, process, result, progress]() {
+                load(algo, formatCode, opNum, process, *result, progress.get());
+            },
+            [result](Napi::Env env) { return loadState(env, *result); });
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/**Sets the iterator and position back to the very beginning.
+/**Sets the iterator and position back to the very beginning by restoring the pinned checkpoint of the start.
  * atInitial will be true and in most cases atEnd will be false (special case for empty algorithms: atEnd is also true)
  * after this call.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param result changed is set to true if the DD changed
+ */
+void QDDVis::toStart(StepResult& result) {
+    if (qc->empty() || atInitial) return;  //nothing changed
+
+    restoreCheckpoint(0);   //the start is always stored as pinned checkpoint
+    gc.endOfBatch(*dd);
+    atInitial = true;
+    atEnd = false; //now we are definitely not at the end (if there were no operation, so atInitial and atEnd could be true at the same time, if(qc1-empty)
+    // would already have returned
+    result.changed = true;
+}
+
+/**Sets the iterator and position back to the very beginning (see toStart).
  *
  * @param info has no parameters
  * @return true if the DD changed, false otherwise (nothing was done or an error occured)
  */
 Napi::Value QDDVis::ToStart(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    StepResult result;
+    if(AsyncTask::isBusy(env, busy)) return Napi::Boolean::New(env, false);
     if(!ready) {
         Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
         return Napi::Boolean::New(env, false);
-    } else if (qc->empty()) {
-        return Napi::Boolean::New(env, false);
     }
 
-    if(atInitial) return Napi::Boolean::New(env, false);  //nothing changed
-    else {
-        try {
-            dd->decRef(sim);
-            sim = dd->makeZeroState(qc->getNqubits());
-            dd->incRef(sim);
-            atInitial = true;
-            atEnd = false; //now we are definitely not at the end (if there were no operation, so atInitial and atEnd could be true at the same time, if(qc1-empty)
-            // would already have returned
-            iterator = qc->begin();
-            position = 0;
-            measurements.reset();
-
-            return Napi::Boolean::New(env, true);   //something changed
-
-        } catch(std::exception& e) {
-            std::cout << "Exception while going back to the start!" << std::endl;
-            std::cout << e.what() << std::endl;
-            return Napi::Boolean::New(env, false);  //nothing changed
-        }
+    try {
+        toStart(result);
+    } catch(std::exception& e) {
+        std::cout << "Exception while going back to the start!" << std::endl;
+        std::cout << e.what() << std::endl;
+        return Napi::Boolean::New(env, false);  //nothing changed
     }
+    return Napi::Boolean::New(env, result.changed);
+}
+
+/**Same as ToStart, but the checkpoint is restored on a worker thread.
+ *
+ * @param info has no parameters (the first one is ignored, so the call looks the same as for QDDVer)
+ * @return a Promise that resolves to the same boolean as ToStart returns
+ */
+Napi::Value QDDVis::ToStartAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<StepResult>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                toStart(*result);
+            },
+            [result](Napi::Env env) { return Napi::Boolean::New(env, result->changed); });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**Goes back to the previous step of the simulation process by applying the inverse of the last processed operation/DD.
+ * If the last processed operation is irreversible (or a checkpoint exists for the previous step), the previous step is
+ * restored from the checkpoints instead.
  * If atInitial is true, nothing happens instead.
  * atEnd will be false (except when the last operation is irreversible).
  * atInitial could end up being true, depending on the position.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param result is filled with changed and noGoingBack
+ */
+void QDDVis::prev(StepResult& result) {
+    if (qc->empty()) return;
+
+    const bool wasAtEnd = atEnd;
+    if (atEnd) {
+        atEnd = false;
+    } else if (atInitial) {
+        return; //we can't go any further back
+    }
+
+    if (position > 0 && irreversibleBetween(position - 1, position)) {
+        //irreversible operations can't be undone by their inverse
+        if (!restoreCheckpoint(position - 1)) {
+            atEnd = wasAtEnd;
+            result.noGoingBack = true;
+            return;
+        }
+    } else if (position > 0 && checkpoints.has(position - 1)) {
+        restoreCheckpoint(position - 1);
+    } else {
+        stepBack();     //go back to the start before the last processed operation
+    }
+    gc.endOfBatch(*dd);
+    result.changed = true;
+}
+
+Napi::Object QDDVis::prevState(Napi::Env env, const StepResult& result) {
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("changed", Napi::Boolean::New(env, result.changed));
+    state.Set("noGoingBack", Napi::Boolean::New(env, result.noGoingBack));
+    return state;
+}
+
+/**Goes back to the previous step of the simulation process (see prev).
  *
  * @param info has no parameters
  * @return object with members
  * 			changed: true if the DD changed, false otherwise (nothing was done or an error occured)
- * 			noGoingBack: true if the previous operation now is an irreversible operation
+ * 			noGoingBack: true if the last processed operation is irreversible and no checkpoint is left after it, so
+ * 			             it can't be undone (nothing changes then)
  */
 Napi::Value QDDVis::Prev(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-	Napi::Object state = Napi::Object::New(env);
-	state.Set("changed", Napi::Boolean::New(env, false));
-	state.Set("noGoingBack", Napi::Boolean::New(env, false));
-
+    StepResult result;
+	if(AsyncTask::isBusy(env, busy)) return prevState(env, result);
     if(!ready) {
         Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
-        return state;
-    } else if (qc->empty()) {
-        return state;
-    }
-
-    if (atEnd) {
-        atEnd = false;
-    } else if (atInitial) {
-        return state; //we can't go any further back
+        return prevState(env, result);
     }
 
     try {
-        stepBack();     //go back to the start before the last processed operation
-	    state.Set("changed", Napi::Boolean::New(env, true));
-
-	    if (iterator != qc->begin()) {
-		    auto testForMeasureIt = iterator;
-		    --testForMeasureIt;
-		    if ((*testForMeasureIt)->getType() == qc::Measure || (*testForMeasureIt)->getType() == qc::Reset) {
-			    state.Set("noGoingBack", Napi::Boolean::New(env, true));
-		    }
-	    }
-
-	    return state;   //something changed
-
+        prev(result);
     } catch(std::exception& e) {
         std::cout << "Exception while getting the current operation {src: prev}!" << std::endl;
         std::cout << e.what() << std::endl;
-        return state;
     }
+    return prevState(env, result);
+}
+
+/**Same as Prev, but the operation is undone on a worker thread.
+ *
+ * @param info has no parameters (the first one is ignored, so the call looks the same as for QDDVer)
+ * @return a Promise that resolves to the same object as Prev returns
+ */
+Napi::Value QDDVis::PrevAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<StepResult>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                prev(*result);
+            },
+            [result](Napi::Env env) { return prevState(env, *result); });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**Goes forward to the next step of the simulation process by applying the current operation/DD.
+ * Measurements and resets are only stepped over, their first qubit is handed to the client which then conducts them via
+ * ConductIrreversibleOperation.
  * If atEnd is true, nothing happens instead.
  * atInitial will be false and atEnd could end up being true, depending on the position.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param result is filled with changed, nextIsIrreversible, conductIrreversibleOperation, parameter and total
+ */
+void QDDVis::next(StepResult& result) {
+    if (qc->empty()) return;
+
+    if(atInitial){
+        atInitial = false;
+    } else if(atEnd) {
+        return; //we can't go any further ahead
+    }
+
+    result.changed = true;
+    const auto type = (*iterator)->getType();
+    if (type == qc::Reset || type == qc::Measure) {
+        if (type == qc::Reset) {
+            const auto& qubits = (*iterator)->getTargets();
+            result.parameter.qubit = qubits.front();
+            result.total = qubits.size();
+        } else {
+            const auto& qubits = (*iterator)->getControls();
+            result.parameter.qubit = qubits.front().qubit;
+            result.parameter.cbit = (long)(*iterator)->getTargets().front();
+            result.total = qubits.size();
+        }
+        std::tie(result.parameter.pzero, result.parameter.pone) = getProbabilities(result.parameter.qubit);
+        result.conductIrreversibleOperation = true;
+
+        iterator++; // advance iterator
+        position++;
+        if (iterator == qc->end()) {    //qc1->end() is after the last operation in the iterator
+            atEnd = true;
+        }
+    } else {
+        stepForward(); //process the next operation
+        gc.endOfBatch(*dd);
+    }
+
+    result.nextIsIrreversible = iterator != qc->end() &&
+            ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset);
+}
+
+Napi::Object QDDVis::nextState(Napi::Env env, const StepResult& result) {
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("changed", Napi::Boolean::New(env, result.changed));
+    state.Set("conductIrreversibleOperation", Napi::Boolean::New(env, result.conductIrreversibleOperation));
+    state.Set("nextIsIrreversible", Napi::Boolean::New(env, result.nextIsIrreversible));
+    if (result.conductIrreversibleOperation) {
+        Napi::Object parameter = Napi::Object::New(env);
+        parameter.Set("qubit", Napi::Number::New(env, result.parameter.qubit));
+        parameter.Set("pzero", Napi::Number::New(env, result.parameter.pzero));
+        parameter.Set("pone", Napi::Number::New(env, result.parameter.pone));
+        if (result.parameter.cbit >= 0) parameter.Set("cbit", Napi::Number::New(env, result.parameter.cbit));
+        parameter.Set("count", Napi::Number::New(env, 0));
+        parameter.Set("total", Napi::Number::New(env, result.total));
+        state.Set("parameter", parameter);
+    }
+    return state;
+}
+
+/**Goes forward to the next step of the simulation process (see next).
  *
  * @param info has no parameters
  * @return object with members
@@ -447,92 +794,81 @@ Napi::Value QDDVis::Prev(const Napi::CallbackInfo& info) {
  */
 Napi::Value QDDVis::Next(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-	Napi::Object state = Napi::Object::New(env);
-	state.Set("changed", Napi::Boolean::New(env, false));
-	state.Set("conductIrreversibleOperation", Napi::Boolean::New(env, false));
-	state.Set("nextIsIrreversible", Napi::Boolean::New(env, false));
-
+    StepResult result;
+	if(AsyncTask::isBusy(env, busy)) return nextState(env, result);
 	if(!ready) {
         Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
-        return state;
-    } else if (qc->empty()) {
-        return state;
-    }
-
-    if(atInitial){
-        atInitial = false;
-    } else if(atEnd) {
-        return state; //we can't go any further ahead
+        return nextState(env, result);
     }
 
     try {
-	    state.Set("changed", Napi::Boolean::New(env, true));
-
-	    if ((*iterator)->getType() == qc::Reset) {
-
-		    auto qubits = (*iterator)->getTargets();
-		    auto totalResets = qubits.size();
-		    auto qubitToReset = qubits.front();
-		    auto qubitsReset = 0;
-		    fp pzero, pone;
-		    std::tie(pzero, pone) = getProbabilities(qubitToReset);
-
-		    Napi::Object reset = Napi::Object::New(env);
-		    reset.Set("qubit", Napi::Number::New(env, qubitToReset));
-		    reset.Set("pzero", Napi::Number::New(env, pzero));
-		    reset.Set("pone", Napi::Number::New(env, pone));
-		    reset.Set("count", Napi::Number::New(env, qubitsReset));
-		    reset.Set("total", Napi::Number::New(env, totalResets));
-		    state.Set("parameter", reset);
-		    state.Set("conductIrreversibleOperation", Napi::Boolean::New(env, true));
-
-		    iterator++; // advance iterator
-		    position++;
-		    if (iterator == qc->end()) {    //qc1->end() is after the last operation in the iterator
-			    atEnd = true;
-		    }
-	    } else if ((*iterator)->getType() == qc::Measure) {
-
-			auto qubits = (*iterator)->getControls();
-			auto cbits = (*iterator)->getTargets();
-			auto totalMeasurements = qubits.size();
-			auto qubitToMeasure = qubits.front().qubit;
-			auto cbitToStore = cbits.front();
-			auto qubitsMeasured = 0;
-			fp pzero, pone;
-			std::tie(pzero, pone) = getProbabilities(qubitToMeasure);
-
-		    Napi::Object measurement = Napi::Object::New(env);
-		    measurement.Set("qubit", Napi::Number::New(env, qubitToMeasure));
-		    measurement.Set("pzero", Napi::Number::New(env, pzero));
-		    measurement.Set("pone", Napi::Number::New(env, pone));
-		    measurement.Set("cbit", Napi::Number::New(env, cbitToStore));
-		    measurement.Set("count", Napi::Number::New(env, qubitsMeasured));
-		    measurement.Set("total", Napi::Number::New(env, totalMeasurements));
-		    state.Set("parameter", measurement);
-		    state.Set("conductIrreversibleOperation", Napi::Boolean::New(env, true));
-
-		    iterator++; // advance iterator
-		    position++;
-		    if (iterator == qc->end()) {    //qc1->end() is after the last operation in the iterator
-			    atEnd = true;
-		    }
-	    } else {
-		    stepForward(); //process the next operation
-	    }
-
-	    if (iterator != qc->end() && ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset)) {
-		    state.Set("nextIsIrreversible", Napi::Boolean::New(env, true));
-	    }
-        return state;
+        next(result);
     } catch(std::exception& e) {
         std::cout << "Exception while getting the current operation {src: next}!" << std::endl;
         std::cout << e.what() << std::endl;
-        return state;
     }
+    return nextState(env, result);
+}
+
+/**Same as Next, but the operation is applied on a worker thread.
+ *
+ * @param info has no parameters (the first one is ignored, so the call looks the same as for QDDVer)
+ * @return a Promise that resolves to the same object as Next returns
+ */
+Napi::Value QDDVis::NextAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<StepResult>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                next(*result);
+            },
+            [result](Napi::Env env) { return nextState(env, *result); });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Processes all operations until the iterator points to the very end, a barrier or an irreversible operation is reached.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param result is filled with changed, nextIsIrreversible, barrier, nops and cancelled
+ * @param progress if not nullptr, processing stops early when it says so (the state stays at the last applied operation)
+ */
+void QDDVis::toEnd(StepResult& result, Progress* progress) {
+    if (qc->empty() || atEnd) return; //nothing changed
+
+    atInitial = false;  //now we are definitely not at the beginning (if there were no operation, so atInitial and atEnd could be true at the same time, if(qc1-empty)
+    // would already have returned
+    result.changed = true;
+    while (!atEnd) {
+        if ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset) {
+            result.nextIsIrreversible = true;
+            break;
+        } else if ((*iterator)->getType() == qc::Barrier) {
+            ++result.nops;
+            stepForward(); //process the barrier
+            result.barrier = true;
+            break;
+        } else {
+            ++result.nops;
+            stepForward(); //process the next operation
+        }
+        if(progress != nullptr && progress->step(position, *dd, sim)) {
+            result.cancelled = true;
+            break;
+        }
+    }
+    gc.endOfBatch(*dd);
+}
+
+Napi::Object QDDVis::endState(Napi::Env env, const StepResult& result) {
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("changed", Napi::Boolean::New(env, result.changed));
+    state.Set("nextIsIrreversible", Napi::Boolean::New(env, result.nextIsIrreversible));
+    state.Set("barrier", Napi::Boolean::New(env, result.barrier));
+    state.Set("nops", Napi::Number::New(env, result.nops));
+    state.Set("cancelled", Napi::Boolean::New(env, result.cancelled));
+    return state;
+}
+
 /**Processes all operations until the iterator points to the very end, a barrier or an irreversible operation is reached.
  *
  *
@@ -541,152 +877,158 @@ Napi::Value QDDVis::Next(const Napi::CallbackInfo& info) {
  * 			changed: true if the DD changed, false otherwise (nothing was done or an error occured)
  * 			nextIsIrreversible: true if the following operation is irreversible
  * 			barrier: true if a barrier was encountered
+ * 			nops: number of processed operations
  */
 Napi::Value QDDVis::ToEnd(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-	Napi::Object state = Napi::Object::New(env);
-	state.Set("changed", Napi::Boolean::New(env, false));
-	state.Set("nextIsIrreversible", Napi::Boolean::New(env, false));
-	state.Set("barrier", Napi::Boolean::New(env, false));
-
+    StepResult result;
+    if(AsyncTask::isBusy(env, busy)) return endState(env, result);
 	if(!ready) {
         Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
-        return state;
-    } else if (qc->empty()) {
-        return state;
+        return endState(env, result);
+    }
+
+    try {
+        toEnd(result);
+    } catch(std::exception& e) {
+        std::cout << "Exception while going to the end!" << std::endl;
+        std::cout << e.what() << std::endl;
+    }
+    return endState(env, result);
+}
+
+/**Same as ToEnd, but the operations are processed on a worker thread.
+ *
+ * @param info takes an optional options object (see Progress) as second parameter to receive progress events and to set
+ *          a timeout in ms (the first one is ignored, so the call looks the same as for QDDVer)
+ * @return a Promise that resolves to the same object as ToEnd returns, cancelled is true if the processing stopped
+ *          early because of Cancel or the timeout
+ */
+Napi::Value QDDVis::ToEndAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<StepResult>();
+    auto progress = std::make_shared<Progress>(info.Env(), info[1], cancelRequests);   //info[0] is algo1 for QDDVer
+    return AsyncTask::start(info, busy,
+            [this, result, progress]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                toEnd(*result, progress.get());
+            },
+            [result](Napi::Env env) { return endState(env, *result); });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Depending on the current position of the iterator and the given target position this function either applies inverse
+ * operations/DDs like Prev or operations/DDs normally like Next. When going back, the nearest checkpoint is restored
+ * instead if replaying from it is cheaper than undoing every operation or if an irreversible operation lies in between.
+ * atInitial and atEnd could be anything after this call.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param targetPos the position the iterator should point at after this call (clamped to the number of operations)
+ * @param result is filled with changed, nextIsIrreversible, noGoingBack, reset, nops and cancelled
+ * @param progress if not nullptr, processing stops early when it says so (the state stays at the last applied operation)
+ */
+void QDDVis::toLine(unsigned int targetPos, StepResult& result, Progress* progress) {
+    if(targetPos > qc->getNops()) targetPos = qc->getNops();    //we can't go further than to the end
+
+    if (iterator != qc->end() && ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset)) {
+        result.nextIsIrreversible = true;
+    }
+    if(position == targetPos) return;   //nothing changed
+
+    unsigned long long nops = 0;
+    if (targetPos < position) {
+        unsigned int checkpointPos = 0;
+        checkpoints.nearest(targetPos, checkpointPos);
+        const bool irreversible = irreversibleBetween(targetPos, position);
+        // replaying from the nearest checkpoint can be cheaper than undoing every operation
+        if ((targetPos - checkpointPos < position - targetPos || irreversible) && restoreCheckpoint(targetPos)) {
+            result.reset = true;
+            result.changed = true;
+            result.nextIsIrreversible = iterator != qc->end() &&
+                    ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset);
+        } else if (irreversible) {  //no checkpoint is left after the irreversible operation, so we can't go back
+            result.noGoingBack = true;
+            return;
+        } else {
+            while(position > targetPos) {
+                ++nops;
+                stepBack();
+                result.changed = true;
+                result.nextIsIrreversible = false;
+                if(progress != nullptr && progress->step(position, *dd, sim)) {
+                    result.cancelled = true;
+                    break;
+                }
+            }
+        }
     }
 
-    if(atEnd) return state; //nothing changed
-    else {
-        atInitial = false;  //now we are definitely not at the beginning (if there were no operation, so atInitial and atEnd could be true at the same time, if(qc1-empty)
-        // would already have returned
-        try {
-	        state.Set("changed", Napi::Boolean::New(env, true));
-	        unsigned long long nops = 0;
-	        while (!atEnd) {
-		        if ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset) {
-			        state.Set("nextIsIrreversible", Napi::Boolean::New(env, true));
-			        break;
-		        } else if ((*iterator)->getType() == qc::Barrier) {
-			        ++nops;
-			        stepForward(); //process the barrier
-			        state.Set("barrier", Napi::Boolean::New(env, true));
-			        break;
-		        } else {
-		        	++nops;
-			        stepForward(); //process the next operation
-		        }
-	        }
-	        state.Set("nops", Napi::Number::New(env, nops));
-	        return state;
-        } catch(std::exception& e) {
-            std::cout << "Exception while going to the end!" << std::endl;
-            std::cout << e.what() << std::endl;
-            return state;
+    while (!result.cancelled && position < targetPos) {
+        if ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset) {
+            result.nextIsIrreversible = true;
+            break;
+        } else {
+            ++nops;
+            stepForward(); //process the next operation
+        }
+        result.changed = true;
+        if(progress != nullptr && progress->step(position, *dd, sim)) {
+            result.cancelled = true;
+            break;
         }
     }
+    //after restoring a checkpoint the client expects the number of operations from the start
+    result.nops = result.reset ? position : nops;
+    gc.endOfBatch(*dd);
+
+    atInitial = false;
+    atEnd = false;
+    if(position == 0) atInitial = true;
+    else if(position == qc->getNops()) atEnd = true;
+}
+
+Napi::Object QDDVis::lineState(Napi::Env env, const StepResult& result) {
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("changed", Napi::Boolean::New(env, result.changed));
+    state.Set("noGoingBack", Napi::Boolean::New(env, result.noGoingBack));
+    state.Set("nextIsIrreversible", Napi::Boolean::New(env, result.nextIsIrreversible));
+    state.Set("reset", Napi::Boolean::New(env, result.reset));
+    state.Set("nops", Napi::Number::New(env, result.nops));
+    state.Set("cancelled", Napi::Boolean::New(env, result.cancelled));
+    return state;
 }
 
 /**Depending on the current position of the iterator and the given parameter this function either applies inverse
- * operations/DDs like Prev or operations/DDs normally like Next.
- * atInitial and atEnd could be anything after this call.
+ * operations/DDs like Prev or operations/DDs normally like Next (see toLine).
  *
  * @param info takes one parameter that determines to which position the iterator should point at after this call
- * @return true if the DD changed, false otherwise (nothing was done or an error occured)
+ * @return object with members
+ * 			changed: true if the DD changed, false otherwise (nothing was done or an error occured)
+ * 			nextIsIrreversible: true if the following operation is irreversible
+ * 			noGoingBack: true if an irreversible operation lies between the target and the current position and no
+ * 			             checkpoint is left after it, so the target can't be reached (nothing changes then)
+ * 			reset: true if a checkpoint was restored, nops then counts the operations from the start
+ * 			nops: number of operations that were applied or undone
  */
 Napi::Value QDDVis::ToLine(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
-	Napi::Object state = Napi::Object::New(env);
-	state.Set("changed", Napi::Boolean::New(env, false));
-	state.Set("noGoingBack", Napi::Boolean::New(env, false));
-	state.Set("nextIsIrreversible", Napi::Boolean::New(env, false));
-	state.Set("reset", Napi::Boolean::New(env, false));
+    StepResult result;
+    if(AsyncTask::isBusy(env, busy)) return lineState(env, result);
 
 	//check if the correct parameters have been passed
     if(info.Length() < 1) {
         Napi::RangeError::New(env, "Need 1 (unsigned int) argument!").ThrowAsJavaScriptException();
-        return state;
+        return lineState(env, result);
     }
     if (!info[0].IsNumber()) {  //line number/position
         Napi::TypeError::New(env, "arg1: unsigned int expected!").ThrowAsJavaScriptException();
-        return state;
+        return lineState(env, result);
     }
 
-    unsigned int param = (unsigned int)info[0].As<Napi::Number>();
-    if(param > qc->getNops()) param = qc->getNops();    //we can't go further than to the end
-    const unsigned int targetPos = param;
-
+    const unsigned int targetPos = (unsigned int)info[0].As<Napi::Number>();
     try {
-	    if (iterator != qc->begin()) {
-		    auto testForMeasureIt = iterator;
-		    --testForMeasureIt;
-		    if ((*testForMeasureIt)->getType() == qc::Measure || (*testForMeasureIt)->getType() == qc::Reset) {
-			    state.Set("noGoingBack", Napi::Boolean::New(env, true));
-		    }
-	    }
-	    if (iterator != qc->end() && ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset)) {
-		    state.Set("nextIsIrreversible", Napi::Boolean::New(env, true));
-	    }
-        if(position == targetPos) return state;   //nothing changed
-
-	    unsigned long long nops = 0;
-	    if (targetPos < position) {
-		    unsigned int distanceFromPosition = position - targetPos;
-		    // if target position is closer to start as to current position computation can be restarted
-	        if( targetPos < distanceFromPosition) {
-		        state.Set("reset", Napi::Boolean::New(env, true));
-		        state.Set("changed", Napi::Boolean::New(env, true));
-		        state.Set("nextIsIrreversible", Napi::Boolean::New(env, false));
-		        state.Set("noGoingBack", Napi::Boolean::New(env, true));
-
-		        dd->decRef(sim);
-		        sim = dd->makeZeroState(qc->getNqubits());
-		        dd->incRef(sim);
-		        atInitial = true;
-		        atEnd = false;
-		        iterator = qc->begin();
-		        position = 0;
-		        measurements.reset();
-		        if ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset) {
-			        state.Set("nextIsIrreversible", Napi::Boolean::New(env, true));
-		        }
-            } else {
-		        state.Set("noGoingBack", Napi::Boolean::New(env, false));
-		        while(position > targetPos) {
-			        auto testForMeasureIt = iterator;
-			        --testForMeasureIt;
-			        if ((*testForMeasureIt)->getType() == qc::Measure || (*testForMeasureIt)->getType() == qc::Reset) {
-				        state.Set("noGoingBack", Napi::Boolean::New(env, true));
-				        break;
-			        }
-					++nops;
-			        stepBack();
-			        state.Set("changed", Napi::Boolean::New(env, true));
-			        state.Set("nextIsIrreversible", Napi::Boolean::New(env, false));
-		        }
-        	}
-        }
-
-	    while (position < targetPos) {
-		    if ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset) {
-			    state.Set("nextIsIrreversible", Napi::Boolean::New(env, true));
-			    break;
-		    } else {
-			    ++nops;
-			    stepForward(); //process the next operation
-		    }
-		    state.Set("changed", Napi::Boolean::New(env, true));
-		    state.Set("noGoingBack", Napi::Boolean::New(env, false));
-	    }
-	    state.Set("nops", Napi::Number::New(env, nops));
-
-        atInitial = false;
-        atEnd = false;
-        if(position == 0) atInitial = true;
-        else if(position == qc->getNops()) atEnd = true;
-
-        return state;   //something changed
+        toLine(targetPos, result);
+        return lineState(env, result);
 
     } catch(std::exception& e) {
         std::string msg = "Exception while going to line ";// + position + " to " + targetPos;
@@ -697,11 +1039,64 @@ Napi::Value QDDVis::ToLine(const Napi::CallbackInfo &info) {
         std::cout << "Exception while going from " << position << " to " << targetPos << std::endl;
         std::cout << e.what() << std::endl;
         Napi::Error::New(env, msg).ThrowAsJavaScriptException();
-        return state;
+        return lineState(env, result);
+    }
+}
+
+/**Same as ToLine, but the operations are applied or undone on a worker thread.
+ *
+ * @param info takes one parameter that determines to which position the iterator should point at after this call and
+ *          an optional options object (see Progress) as third parameter (the second one is ignored, so the call looks
+ *          the same as for QDDVer)
+ * @return a Promise that resolves to the same object as ToLine returns, cancelled is true if the target wasn't reached
+ *          because of Cancel or the timeout
+ */
+Napi::Value QDDVis::ToLineAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if(info.Length() < 1) {
+        Napi::RangeError::New(env, "Need 1 (unsigned int) argument!").ThrowAsJavaScriptException();
+        return env.Undefined();
     }
+    if (!info[0].IsNumber()) {  //line number/position
+        Napi::TypeError::New(env, "arg1: unsigned int expected!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    const unsigned int targetPos = (unsigned int)info[0].As<Napi::Number>();
+    auto result = std::make_shared<StepResult>();
+    auto progress = std::make_shared<Progress>(env, info[2], cancelRequests);     //info[1] is algo1 for QDDVer
+    return AsyncTask::start(info, busy,
+            [this, targetPos, result, progress]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                toLine(targetPos, *result, progress.get());
+            },
+            [result](Napi::Env env) { return lineState(env, *result); });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Exports the current state of the simulation with the current export options.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @return the current state of the simulation as DD in the .dot-format (shared with the export cache)
+ */
+ExportCache::Dot QDDVis::exportDD() {
+    const unsigned int options = (showColors ? 1u : 0u) | (showEdgeLabels ? 2u : 0u) | (showClassic ? 4u : 0u);
+    return exports.dot(*dd, sim, options, [this]() {
+        std::stringstream ss{};
+        dd::toDot(sim, ss, true, this->showColors, this->showEdgeLabels, this->showClassic);
+        return ss.str();
+    });
+}
+
+/**Exports the current state as binary node table (see DDSerializer).
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @return the serialized DD (shared with the export cache)
+ */
+ExportCache::Binary QDDVis::exportBinary() {
+    return exports.binary(*dd, sim, [this]() { return DDSerializer::serialize(sim, true); });
+}
+
 /**Creates a DD in the .dot-format for the current state of the simulation.
  *
  * @param info has no parameters
@@ -709,18 +1104,14 @@ Napi::Value QDDVis::ToLine(const Napi::CallbackInfo &info) {
  */
 Napi::Value QDDVis::GetDD(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return Napi::String::New(env, "-1");
     if(!ready) {
         Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
         return Napi::String::New(env, "-1");
     }
 
-    std::stringstream ss{};
     try {
-        //std::cout << "GetDD() called with colored=" << this->showColors << ", edgeLabels=" << this->showEdgeLabels << ", classic=" << this->showClassic << std::endl;
-        dd::toDot(sim, ss, true, this->showColors, this->showEdgeLabels, this->showClassic);
-        //std::cout << "Flags afer toDot: " << this->showColors << ", " << this->showEdgeLabels << ", " << this->showClassic << std::endl;
-        std::string str = ss.str();
-        return Napi::String::New(env, str);
+        return Napi::String::New(env, *exportDD());
 
     } catch(std::exception& e) {
         std::cout << "Exception while getting the DD: " << e.what() << std::endl;
@@ -731,6 +1122,302 @@ Napi::Value QDDVis::GetDD(const Napi::CallbackInfo& info) {
     }
 }
 
+/**Same as GetDD, but the DD is exported on a worker thread.
+ *
+ * @param info has no parameters
+ * @return a Promise that resolves to the string GetDD returns
+ */
+Napi::Value QDDVis::GetDDAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<ExportCache::Dot>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                *result = exportDD();
+            },
+            [result](Napi::Env env) { return Napi::String::New(env, **result); });
+}
+
+/**Creates the current DD as compact binary node table (see DDSerializer for the layout). Unlike GetDD it doesn't
+ * depend on the export options, since colors and labels are up to the client.
+ *
+ * @param info has no parameters
+ * @return Uint8Array containing the serialized DD
+ */
+Napi::Value QDDVis::GetDDBinary(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return DDSerializer::toUint8Array(env, exportBinary());
+}
+
+/**Same as GetDDBinary, but the DD is serialized on a worker thread.
+ *
+ * @param info has no parameters
+ * @return a Promise that resolves to the Uint8Array GetDDBinary returns
+ */
+Napi::Value QDDVis::GetDDBinaryAsync(const Napi::CallbackInfo& info) {
+    auto result = std::make_shared<ExportCache::Binary>();
+    return AsyncTask::start(info, busy,
+            [this, result]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                *result = exportBinary();
+            },
+            [result](Napi::Env env) { return DDSerializer::toUint8Array(env, *result); });
+}
+
+/**Exports the current DD as difference to the DD of the previous GetDDDiff-call (see DDDiff), so stepping only
+ * transfers the nodes that actually changed.
+ *
+ * @param info has an optional boolean argument (full) - if it is true, the diff starts from the empty graph (e.g. because
+ *          the client lost track of its version)
+ * @return null if the DD is structurally identical to the last export, otherwise the object described in
+ *          DDDiff::toObject
+ */
+Napi::Value QDDVis::GetDDDiff(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if(info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>()) ddDiff.clear(*dd);
+    return DDDiff::toObject(env, ddDiff.diff(*dd, sim, true));
+}
+
+/**Same as GetDDDiff, but the diff is computed on a worker thread.
+ *
+ * @param info has an optional boolean argument (full), see GetDDDiff
+ * @return a Promise that resolves to what GetDDDiff returns
+ */
+Napi::Value QDDVis::GetDDDiffAsync(const Napi::CallbackInfo& info) {
+    const bool full = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>();
+    auto result = std::make_shared<DDDiff::Result>();
+    return AsyncTask::start(info, busy,
+            [this, result, full]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                if(full) ddDiff.clear(*dd);
+                *result = ddDiff.diff(*dd, sim, true);
+            },
+            [result](Napi::Env env) { return DDDiff::toObject(env, *result); });
+}
+
+/**Lays out the current DD (see Layout), so the client only has to draw it. Nodes that were part of the previous
+ * layout keep their ids and stay where they were as far as possible.
+ *
+ * @param info has an optional boolean argument (fresh) - if it is true, the previous layout is ignored
+ * @return the object described in Layout::toObject
+ */
+Napi::Value QDDVis::GetLayout(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if(info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>()) graphLayout.clear(*dd);
+    return Layout::toObject(env, graphLayout.layout(*dd, sim, true));
+}
+
+/**Same as GetLayout, but the layout is computed on a worker thread.
+ *
+ * @param info has an optional boolean argument (fresh), see GetLayout
+ * @return a Promise that resolves to what GetLayout returns
+ */
+Napi::Value QDDVis::GetLayoutAsync(const Napi::CallbackInfo& info) {
+    const bool fresh = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>();
+    auto result = std::make_shared<Layout::Result>();
+    return AsyncTask::start(info, busy,
+            [this, result, fresh]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                if(fresh) graphLayout.clear(*dd);
+                *result = graphLayout.layout(*dd, sim, true);
+            },
+            [result](Napi::Env env) { return Layout::toObject(env, *result); });
+}
+
+/**Exports the current DD with at most a given number of expanded nodes (see LevelOfDetail), the rest is collapsed
+ * into summary nodes.
+ *
+ * @param info has an optional object argument {budget, expand}, see LevelOfDetail::parseOptions
+ * @return the object described in LevelOfDetail::toObject
+ */
+Napi::Value QDDVis::GetDDSummary(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    unsigned int budget;
+    std::vector<std::uint32_t> expand;
+    if(!LevelOfDetail::parseOptions(info, budget, expand)) return env.Undefined();
+    return LevelOfDetail::toObject(env, levelOfDetail.build(*dd, sim, true, budget, expand));
+}
+
+/**Same as GetDDSummary, but the export is computed on a worker thread.
+ *
+ * @param info has an optional object argument {budget, expand}, see LevelOfDetail::parseOptions
+ * @return a Promise that resolves to what GetDDSummary returns
+ */
+Napi::Value QDDVis::GetDDSummaryAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    unsigned int budget;
+    auto expand = std::make_shared<std::vector<std::uint32_t>>();
+    if(!LevelOfDetail::parseOptions(info, budget, *expand)) return env.Undefined();
+    auto result = std::make_shared<LevelOfDetail::Result>();
+    return AsyncTask::start(info, busy,
+            [this, result, budget, expand]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                *result = levelOfDetail.build(*dd, sim, true, budget, *expand);
+            },
+            [result](Napi::Env env) { return LevelOfDetail::toObject(env, *result); });
+}
+
+/**Follows the given path from the root and exports only the sub-DD below it. Only the nodes of the sub-DD are visited.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @param path values ('0' or '1') of the qubits n-1, n-2, ... starting at the root
+ * @return the normalized sub-DD in the .dot-format together with its weight and probability
+ * @throws std::invalid_argument if path is longer than the number of qubits or contains other characters
+ */
+QDDVis::SubDD QDDVis::exportSubDD(const std::string& path) {
+    if(path.size() > qc->getNqubits()) throw std::invalid_argument("The path is longer than the number of qubits!");
+    if(path.find_first_not_of("01") != std::string::npos) {
+        throw std::invalid_argument("The path may only consist of '0' and '1'!");
+    }
+
+    //weight of the path, i.e. the product of the weights of its edges
+    fp re = CN::val(sim.w.r);
+    fp im = CN::val(sim.w.i);
+    dd::Edge e = sim;
+    SubDD sub{};
+    for(char bit : path) {
+        if(CN::equalsZero(e.w)) return sub;
+        e = e.p->e[bit == '1' ? 2 : 0];
+        const fp wr = CN::val(e.w.r);
+        const fp wi = CN::val(e.w.i);
+        const fp r = re * wr - im * wi;
+        im = re * wi + im * wr;
+        re = r;
+    }
+    if(CN::equalsZero(e.w)) return sub;
+
+    std::unordered_map<dd::NodePtr, fp> memo;
+    const fp norm = dd::Package::isTerminal(e) ? 1 : squaredNorm(e.p, memo);
+    const fp length = std::sqrt(norm);
+    sub.re = re * length;
+    sub.im = im * length;
+    sub.probability = (re * re + im * im) * norm;
+    if(sub.probability <= 0) return sub;
+
+    dd::Complex w = dd->cn.getCachedComplex(1 / length, 0);
+    std::stringstream ss{};
+    dd::toDot(dd::Edge{e.p, w}, ss, true, this->showColors, this->showEdgeLabels, this->showClassic);
+    dd->cn.releaseCached(w);
+    sub.dot = ss.str();
+    return sub;
+}
+
+/**
+ *
+ * @param p a node of a vector DD
+ * @param memo squared norms of the nodes that were already visited
+ * @return squared norm of the vector p represents (without the weight of the edge pointing to p)
+ */
+fp QDDVis::squaredNorm(dd::NodePtr p, std::unordered_map<dd::NodePtr, fp>& memo) {
+    auto it = memo.find(p);
+    if(it != memo.end()) return it->second;
+    fp norm = 0;
+    for(int i = 0; i <= 2; i += 2) {
+        const dd::Edge& e = p->e[i];
+        if(CN::equalsZero(e.w)) continue;
+        norm += CN::mag2(e.w) * (dd::Package::isTerminal(e) ? 1 : squaredNorm(e.p, memo));
+    }
+    memo.emplace(p, norm);
+    return norm;
+}
+
+/**Exports the part of the current state below a path from the root, e.g. "10" for qubit n-1 = 1 and qubit n-2 = 0.
+ *
+ * @param info has one string argument (path, see exportSubDD)
+ * @return {dot, weight: {re, im}, probability} with the normalized sub-DD in the .dot-format (the empty string if the
+ *          path has probability 0) and the weight it has in the state
+ */
+Napi::Value QDDVis::GetSubDD(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if(info.Length() != 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "String expected as path!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    try {
+        return subDDToObject(env, exportSubDD(info[0].As<Napi::String>().Utf8Value()));
+    } catch(std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+}
+
+/**Same as GetSubDD, but the sub-DD is exported on a worker thread.
+ *
+ * @param info has one string argument (path, see exportSubDD)
+ * @return a Promise that resolves to what GetSubDD returns
+ */
+Napi::Value QDDVis::GetSubDDAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(info.Length() != 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "String expected as path!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    const std::string path = info[0].As<Napi::String>().Utf8Value();
+    auto result = std::make_shared<SubDD>();
+    return AsyncTask::start(info, busy,
+            [this, result, path]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                *result = exportSubDD(path);
+            },
+            [result](Napi::Env env) { return subDDToObject(env, *result); });
+}
+
+/**
+ *
+ * @param env the environment to create the object in
+ * @param sub result of exportSubDD
+ * @return {dot, weight: {re, im}, probability}
+ */
+Napi::Object QDDVis::subDDToObject(Napi::Env env, const SubDD& sub) {
+    Napi::Object weight = Napi::Object::New(env);
+    weight.Set("re", Napi::Number::New(env, sub.re));
+    weight.Set("im", Napi::Number::New(env, sub.im));
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("dot", Napi::String::New(env, sub.dot));
+    obj.Set("weight", weight);
+    obj.Set("probability", Napi::Number::New(env, sub.probability));
+    return obj;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**Asks the running asynchronous call (loadAsync, toEndAsync or toLineAsync) to stop after the operation it is currently
+ * applying. Its Promise then resolves normally with cancelled set to true and the state at the last applied operation.
+ * Calls that are still queued behind it are cancelled as well (they stop right away once they start), calls made
+ * afterwards aren't.
+ * Does nothing if no asynchronous call is running.
+ *
+ * @param info has no parameters
+ */
+void QDDVis::Cancel(const Napi::CallbackInfo& info) {
+    if(busy) cancelRequests++;
+}
+
 /**Updates the three fields of this object that determine with which options the DD should be exported (on the next
  * GetDD-call).
  *
@@ -738,6 +1425,7 @@ Napi::Value QDDVis::GetDD(const Napi::CallbackInfo& info) {
  */
 void QDDVis::UpdateExportOptions(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return;
     //check if the correct parameters have been passed
     if(info.Length() != 3) {
         Napi::RangeError::New(env, "Need 3 (bool, bool, bool) arguments!").ThrowAsJavaScriptException();
@@ -782,13 +1470,469 @@ Napi::Value QDDVis::IsReady(const Napi::CallbackInfo& info) {
     return Napi::Boolean::New(env, this->ready);
 }
 
+/**Marks the object as not ready and gives its dd::Package back to the pool, the next load acquires a new one.
+ *
+ * @param info has no parameters
+ */
 void QDDVis::Unready(const Napi::CallbackInfo& info) {
-    this->ready = false;
+    if(AsyncTask::isBusy(info.Env(), busy)) return;
+    releasePackage();
+}
+
+/**Same as Unready, used when the session is cleaned up.
+ *
+ * @param info has no parameters
+ */
+void QDDVis::Release(const Napi::CallbackInfo& info) {
+    if(AsyncTask::isBusy(info.Env(), busy)) return;
+    releasePackage();
+}
+
+/**Dereferences all DDs of this object and returns its dd::Package to the pool (if it has one).
+ *
+ */
+void QDDVis::releasePackage() {
+    ready = false;
+    if(!dd) return;
+
+    gates.clear(*dd);
+    marginals.clear(*dd);
+    sampler.clear(*dd);
+    ddDiff.clear(*dd);
+    exports.clear(*dd);
+    graphLayout.clear(*dd);
+    levelOfDetail.clear(*dd);
+    checkpoints.clear(*dd);
+    if(sim.p != nullptr) dd->decRef(sim);
+    sim = dd::Edge{};
+    PackagePool::release(std::move(dd));
+}
+
+QDDVis::~QDDVis() {
+    releasePackage();
+}
+
+/**Measures the memory this object currently holds and remembers it for calls while an asynchronous call is busy.
+ *
+ * @return the estimated memory usage of this object
+ */
+MemoryUsage QDDVis::measureMemory() {
+    memory = MemoryUsage::of(dd.get(), exports.getBytes() + sampler.getBytes());
+    return memory;
+}
+
+/**Returns the memory usage of the last measurement while an asynchronous call is working on this object, since its
+ * package must not be read meanwhile.
+ *
+ * @param info has no parameters
+ * @return object as described in MemoryUsage::toObject, extended by the members
+ *          busy: whether an asynchronous call is running (and the values are therefore from an earlier measurement)
+ *          checkpoints: number of states stored for random access
+ *          gateCacheEntries: number of operation DDs stored
+ */
+Napi::Value QDDVis::GetMemoryUsage(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const bool running = busy;
+    Napi::Object obj = (running ? memory : measureMemory()).toObject(env);
+    obj.Set("busy", Napi::Boolean::New(env, running));
+    obj.Set("checkpoints", Napi::Number::New(env, running ? 0 : checkpoints.size()));
+    obj.Set("gateCacheEntries", Napi::Number::New(env, running ? 0 : gates.size()));
+    return obj;
+}
+
+/**Frees as much memory as possible without losing the current state: drops all caches and the checkpoints that are
+ * not pinned and forces a garbage collection. Used by the server to shrink sessions that weren't accessed for a while.
+ *
+ * @param info has no parameters
+ * @return number of bytes that were freed (estimated as in MemoryUsage)
+ */
+Napi::Value QDDVis::Compact(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+
+    const std::size_t before = measureMemory().bytes;
+    if(dd) {
+        gates.clear(*dd);
+        marginals.clear(*dd);
+        sampler.clear(*dd);
+        ddDiff.clear(*dd);
+        exports.clear(*dd);
+        graphLayout.clear(*dd);
+        levelOfDetail.clear(*dd);
+        checkpoints.dropUnpinned(*dd);
+        dd->garbageCollect(true);
+    }
+    const std::size_t after = measureMemory().bytes;
+    return Napi::Number::New(env, before > after ? before - after : 0);
+}
+
+/**
+ *
+ * @param info has no parameters
+ * @return object with members
+ *          gateCache: {hits, misses, entries, nodes} of the cache for the DDs of the operations
+ *          exportCache: {hits, misses, entries, bytes} of the cache for the exported DDs
+ *          circuitCache: {hits, misses, entries} of the process-wide cache of parsed algorithms
+ *          scheduler: {workers, pending} number of worker threads and of asynchronous calls queued by all sessions
+ *          gc: {mode, parameter, runs, nodesFreed, time (in µs)} of the garbage collection
+ */
+Napi::Value QDDVis::GetStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    Napi::Object gateCache = Napi::Object::New(env);
+    gateCache.Set("hits", Napi::Number::New(env, gates.getHits()));
+    gateCache.Set("misses", Napi::Number::New(env, gates.getMisses()));
+    gateCache.Set("entries", Napi::Number::New(env, gates.size()));
+    gateCache.Set("nodes", Napi::Number::New(env, gates.getNodes()));
+
+    Napi::Object gcStats = Napi::Object::New(env);
+    gcStats.Set("mode", Napi::String::New(env, GCPolicy::modeName(gc.getMode())));
+    gcStats.Set("parameter", Napi::Number::New(env, gc.getParameter()));
+    gcStats.Set("runs", Napi::Number::New(env, gc.getRuns()));
+    gcStats.Set("nodesFreed", Napi::Number::New(env, gc.getNodesFreed()));
+    gcStats.Set("time", Napi::Number::New(env, gc.getTime()));
+
+    Napi::Object exportCache = Napi::Object::New(env);
+    exportCache.Set("hits", Napi::Number::New(env, exports.getHits()));
+    exportCache.Set("misses", Napi::Number::New(env, exports.getMisses()));
+    exportCache.Set("entries", Napi::Number::New(env, exports.size()));
+    exportCache.Set("bytes", Napi::Number::New(env, exports.getBytes()));
+
+    Napi::Object circuitCache = Napi::Object::New(env);
+    circuitCache.Set("hits", Napi::Number::New(env, CircuitCache::getHits()));
+    circuitCache.Set("misses", Napi::Number::New(env, CircuitCache::getMisses()));
+    circuitCache.Set("entries", Napi::Number::New(env, CircuitCache::size()));
+
+    Napi::Object scheduler = Napi::Object::New(env);
+    scheduler.Set("workers", Napi::Number::New(env, Scheduler::get().getWorkers()));
+    scheduler.Set("pending", Napi::Number::New(env, Scheduler::get().getPending()));
+
+    Napi::Object stats = Napi::Object::New(env);
+    stats.Set("gateCache", gateCache);
+    stats.Set("exportCache", exportCache);
+    stats.Set("circuitCache", circuitCache);
+    stats.Set("scheduler", scheduler);
+    stats.Set("gc", gcStats);
+    return stats;
+}
+
+/**
+ *
+ * @param info has no parameters
+ * @return array with an object {pzero, pone} for every qubit (indexed by qubit) describing the probabilities of
+ *          measuring 0 or 1 for it in the current state
+ */
+Napi::Value QDDVis::GetProbabilities(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    Napi::Array arr = Napi::Array::New(env, qc->getNqubits());
+    for(unsigned short q = 0; q < qc->getNqubits(); q++) {
+        fp pzero, pone;
+        std::tie(pzero, pone) = getProbabilities(q);
+        Napi::Object prob = Napi::Object::New(env);
+        prob.Set("pzero", Napi::Number::New(env, pzero));
+        prob.Set("pone", Napi::Number::New(env, pone));
+        arr.Set(q, prob);
+    }
+    return arr;
+}
+
+/**Checks the parameters of Sample and SampleAsync and throws an error if they are invalid.
+ *
+ * @param info the parameters of the call
+ * @param shots is set to the number of shots
+ * @param seed is set to the given seed or a random one if none was given
+ * @return true if the parameters are valid, false otherwise
+ */
+bool QDDVis::checkSampleArguments(const Napi::CallbackInfo& info, unsigned long long& shots, unsigned long long& seed) {
+    Napi::Env env = info.Env();
+    if(info.Length() < 1 || !info[0].IsNumber() || info[0].As<Napi::Number>().Int64Value() < 0) {
+        Napi::TypeError::New(env, "arg1: unsigned int expected!").ThrowAsJavaScriptException();
+        return false;
+    }
+    if(info.Length() > 1 && !info[1].IsNumber() && !info[1].IsUndefined()) {
+        Napi::TypeError::New(env, "arg2: unsigned int expected!").ThrowAsJavaScriptException();
+        return false;
+    }
+    shots = (unsigned long long)info[0].As<Napi::Number>().Int64Value();
+    if(info.Length() > 1 && info[1].IsNumber()) seed = (unsigned long long)info[1].As<Napi::Number>().Int64Value();
+    else                                        seed = std::random_device{}();
+    return true;
+}
+
+/**
+ *
+ * @param env the environment to create the object in
+ * @param histogram the outcomes of Sampler::sample
+ * @param nqubits number of qubits of the sampled state
+ * @return object with the outcomes as bitstrings (qubit nqubits-1 first) and how often they occurred as values
+ */
+Napi::Object QDDVis::histogramToObject(Napi::Env env, const Sampler::Histogram& histogram, unsigned short nqubits) {
+    Napi::Object obj = Napi::Object::New(env);
+    std::string bits(nqubits, '0');
+    for(const auto& entry : histogram) {
+        for(unsigned short q = 0; q < nqubits; q++) bits[nqubits - 1 - q] = entry.first.test(q) ? '1' : '0';
+        obj.Set(bits, Napi::Number::New(env, entry.second));
+    }
+    return obj;
+}
+
+/**Draws measurement outcomes of all qubits from the current state without changing it.
+ *
+ * @param info takes two parameters
+ *              unsigned int: number of shots
+ *              unsigned int: seed of the random generator (optional, the same seed leads to the same outcomes)
+ * @return object with the drawn outcomes as bitstrings (last qubit first) and how often they occurred as values
+ */
+Napi::Value QDDVis::Sample(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    unsigned long long shots, seed;
+    if(!checkSampleArguments(info, shots, seed)) return env.Undefined();
+
+    return histogramToObject(env, sampler.sample(*dd, sim, shots, seed), qc->getNqubits());
+}
+
+/**Same as Sample, but the outcomes are drawn on a worker thread.
+ *
+ * @param info same parameters as Sample
+ * @return a Promise that resolves to the same object as Sample returns
+ */
+Napi::Value QDDVis::SampleAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    unsigned long long shots, seed;
+    if(!checkSampleArguments(info, shots, seed)) return env.Undefined();
+
+    auto result = std::make_shared<Sampler::Histogram>();
+    auto nqubits = std::make_shared<unsigned short>(0);
+    return AsyncTask::start(info, busy,
+            [this, shots, seed, result, nqubits]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                *nqubits = qc->getNqubits();
+                *result = sampler.sample(*dd, sim, shots, seed);
+            },
+            [result, nqubits](Napi::Env env) { return histogramToObject(env, *result, *nqubits); });
+}
+
+/**Checks the parameters of MeasureRegister and MeasureRegisterAsync and throws a JS exception if they are invalid.
+ *
+ * @param info see MeasureRegister
+ * @param outcomes is set to the given outcomes
+ * @param draw is set to true if no outcomes were given and they have to be drawn
+ * @param seed is set to the given seed or a random one if none was given
+ * @return true if the parameters are valid, false otherwise
+ */
+bool QDDVis::checkRegisterArguments(const Napi::CallbackInfo& info, std::string& outcomes, bool& draw, unsigned long long& seed) {
+    Napi::Env env = info.Env();
+    if(info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "arg1: Object expected!").ThrowAsJavaScriptException();
+        return false;
+    }
+    const auto obj = info[0].As<Napi::Object>();
+    draw = !obj.Has("outcomes");
+    if(!draw) {
+        if(!obj.Get("outcomes").IsString()) {
+            Napi::TypeError::New(env, "outcomes: String expected!").ThrowAsJavaScriptException();
+            return false;
+        }
+        outcomes = obj.Get("outcomes").As<Napi::String>().Utf8Value();
+        if(outcomes.find_first_not_of("01") != std::string::npos) {
+            Napi::TypeError::New(env, "outcomes: only '0' and '1' are allowed!").ThrowAsJavaScriptException();
+            return false;
+        }
+    } else if(obj.Has("seed") && obj.Get("seed").IsNumber()) {
+        seed = (unsigned long long)obj.Get("seed").As<Napi::Number>().Int64Value();
+    } else {
+        seed = std::random_device{}();
+    }
+    return true;
+}
+
+Napi::Object QDDVis::registerState(Napi::Env env, const std::vector<Measurement>& results, bool nextIsIrreversible) {
+    Napi::Object state = Napi::Object::New(env);
+    Napi::Array arr = Napi::Array::New(env, results.size());
+    for(std::size_t i = 0; i < results.size(); i++) {
+        Napi::Object m = Napi::Object::New(env);
+        m.Set("qubit", Napi::Number::New(env, results[i].qubit));
+        if(results[i].cbit >= 0) m.Set("cbit", Napi::Number::New(env, results[i].cbit));
+        m.Set("pzero", Napi::Number::New(env, results[i].pzero));
+        m.Set("pone", Napi::Number::New(env, results[i].pone));
+        m.Set("outcome", Napi::String::New(env, std::string(1, results[i].outcome)));
+        arr.Set(i, m);
+    }
+    state.Set("changed", Napi::Boolean::New(env, true));
+    state.Set("outcomes", arr);
+    state.Set("nextIsIrreversible", Napi::Boolean::New(env, nextIsIrreversible));
+    return state;
+}
+
+/**Conducts the measurement or reset the iterator points at for all of its qubits in one call, instead of Next followed
+ * by one ConductIrreversibleOperation per qubit.
+ *
+ * @param info takes one object parameter with either
+ *              outcomes: string with the outcome ('0' or '1') of every qubit of the operation in their order, or
+ *              seed: unsigned int to draw the outcomes randomly (the same seed leads to the same outcomes)
+ * @return object with members
+ *          changed: true if the operation was conducted
+ *          nextIsIrreversible: true if the following operation is irreversible
+ *          outcomes: array with an object {qubit, cbit (only for measurements), pzero, pone, outcome} per qubit
+ */
+Napi::Value QDDVis::MeasureRegister(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object state = Napi::Object::New(env);
+    state.Set("changed", Napi::Boolean::New(env, false));
+    if(AsyncTask::isBusy(env, busy)) return state;
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return state;
+    }
+    std::string outcomes;
+    bool draw = true;
+    unsigned long long seed = 0;
+    if(!checkRegisterArguments(info, outcomes, draw, seed)) return state;
+
+    try {
+        const auto results = measureRegister(draw ? nullptr : &outcomes, seed);
+        return registerState(env, results, iterator != qc->end() &&
+                ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset));
+    } catch(std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+    }
+    return state;
+}
+
+/**Same as MeasureRegister, but the operation is conducted on a worker thread.
+ *
+ * @param info same parameters as MeasureRegister
+ * @return a Promise that resolves to the same object as MeasureRegister returns, it is rejected if the operation
+ *          couldn't be conducted
+ */
+Napi::Value QDDVis::MeasureRegisterAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::string outcomes;
+    bool draw = true;
+    unsigned long long seed = 0;
+    if(!checkRegisterArguments(info, outcomes, draw, seed)) return env.Undefined();
+
+    auto results = std::make_shared<std::vector<Measurement>>();
+    auto nextIsIrreversible = std::make_shared<bool>(false);
+    return AsyncTask::start(info, busy,
+            [this, outcomes, draw, seed, results, nextIsIrreversible]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                *results = measureRegister(draw ? nullptr : &outcomes, seed);
+                *nextIsIrreversible = iterator != qc->end() &&
+                        ((*iterator)->getType() == qc::Measure || (*iterator)->getType() == qc::Reset);
+            },
+            [results, nextIsIrreversible](Napi::Env env) { return registerState(env, *results, *nextIsIrreversible); });
+}
+
+/**Expands the current state into a newly allocated dense amplitude vector.
+ * Doesn't use any N-API objects, so it can also be called from a worker thread.
+ *
+ * @return 2 * 2^n doubles (interleaved real and imaginary parts)
+ * @throws std::length_error if the algorithm has more than StateVector::MAX_QUBITS qubits
+ */
+std::unique_ptr<double[]> QDDVis::exportStateVector() {
+    if(qc->getNqubits() > StateVector::MAX_QUBITS) {
+        throw std::length_error("The state vector can only be exported for up to " +
+                                std::to_string(StateVector::MAX_QUBITS) + " qubits!");
+    }
+    std::unique_ptr<double[]> amplitudes(new double[2 * (std::size_t{1} << qc->getNqubits())]());
+    StateVector::expand(sim, qc->getNqubits(), amplitudes.get());
+    return amplitudes;
+}
+
+/**Hands the given amplitudes over to JS without copying them. The memory is freed when the ArrayBuffer is collected.
+ *
+ * @param env the environment to create the array in
+ * @param amplitudes result of exportStateVector, released by this call
+ * @param nqubits number of qubits of the state
+ * @return Float64Array of length 2 * 2^nqubits backed by the given memory
+ */
+Napi::Value QDDVis::wrapStateVector(Napi::Env env, std::unique_ptr<double[]>& amplitudes, unsigned short nqubits) {
+    const std::size_t length = 2 * (std::size_t{1} << nqubits);
+    Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, amplitudes.get(), length * sizeof(double),
+            [](Napi::Env /*env*/, void* data) { delete[] static_cast<double*>(data); });
+    amplitudes.release();   //now owned by the ArrayBuffer
+    return Napi::Float64Array::New(env, length, buffer, 0);
+}
+
+/**
+ *
+ * @param info has no parameters
+ * @return Float64Array with the amplitudes of the current state (amplitude i at [2i] (re) and [2i+1] (im), bit q of i
+ *          is the value of qubit q)
+ */
+Napi::Value QDDVis::GetStateVector(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return env.Undefined();
+    if(!ready) {
+        Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    try {
+        auto amplitudes = exportStateVector();
+        return wrapStateVector(env, amplitudes, qc->getNqubits());
+    } catch(std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+}
+
+/**Same as GetStateVector, but the state is expanded on a worker thread.
+ *
+ * @param info has no parameters
+ * @return a Promise that resolves to the same Float64Array as GetStateVector returns
+ */
+Napi::Value QDDVis::GetStateVectorAsync(const Napi::CallbackInfo& info) {
+    auto amplitudes = std::make_shared<std::unique_ptr<double[]>>();
+    auto nqubits = std::make_shared<unsigned short>(0);
+    return AsyncTask::start(info, busy,
+            [this, amplitudes, nqubits]() {
+                if(!ready) throw std::runtime_error("No algorithm loaded!");
+                *nqubits = qc->getNqubits();
+                *amplitudes = exportStateVector();
+            },
+            [amplitudes, nqubits](Napi::Env env) { return wrapStateVector(env, *amplitudes, *nqubits); });
+}
+
+/**Sets when the garbage collection runs while stepping through the algorithm (see GCPolicy).
+ *
+ * @param info takes two parameters
+ *              string: "everyStep" (default), "everyNSteps", "nodeThreshold" or "endOfBatch"
+ *              unsigned int: number of steps for everyNSteps, number of nodes for nodeThreshold (optional otherwise)
+ */
+void QDDVis::SetGCPolicy(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(AsyncTask::isBusy(env, busy)) return;
+    if(info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "arg1: String expected!").ThrowAsJavaScriptException();
+        return;
+    }
+    const unsigned long parameter = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int64Value() : 0;
+    if(!gc.setMode(info[0].As<Napi::String>().Utf8Value(), parameter)) {
+        Napi::Error::New(env, "Invalid GC policy!").ThrowAsJavaScriptException();
+    }
 }
 
 Napi::Value QDDVis::ConductIrreversibleOperation(const Napi::CallbackInfo& info) {
 
 	Napi::Env env = info.Env();
+	if (AsyncTask::isBusy(env, busy)) return env.Undefined();
+	if (!ready) {
+		Napi::Error::New(env, "No algorithm loaded!").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
 
 	if (info.Length() < 1) {
 		Napi::RangeError::New(env, "Need 1 Object(int, double, double, string, int, int, (int)) argument!").ThrowAsJavaScriptException();
@@ -852,6 +1996,9 @@ Napi::Value QDDVis::ConductIrreversibleOperation(const Napi::CallbackInfo& info)
 	state.Set("finished", Napi::Boolean::New(env, false));
 	Napi::Object parameter = Napi::Object::New(env);
 
+	//the state at the current position changes, so checkpoints of a previous outcome are no longer valid
+	checkpoints.dropFrom(*dd, position);
+
 	if (isReset) {
 		// reset operation
 		if (classicalValueToMeasure == "0") {
@@ -864,7 +2011,8 @@ Napi::Value QDDVis::ConductIrreversibleOperation(const Napi::CallbackInfo& info)
 			dd->decRef(sim);
 			sim = tmp;
 
-			dd->garbageCollect();
+			gc.afterStep(*dd);
+			gc.endOfBatch(*dd);
 		} else {
 			// do something in case operation is cancelled
 		}
@@ -882,6 +2030,8 @@ Napi::Value QDDVis::ConductIrreversibleOperation(const Napi::CallbackInfo& info)
 
 	count++;
 	if (count == total) {
+		//the outcome can't be recomputed, so this checkpoint is the only way to go back over the operation later
+		checkpoints.record(*dd, position, sim, measurements, true);
 		state.Set("finished", Napi::Boolean::New(env, true));
 		return state;
 	}
@@ -2,26 +2,104 @@
 #define QDDVIS_H
 
 #include <napi.h>
+#include <atomic>
 #include <string>
+#include <unordered_map>
 
 #include "operations/Operation.hpp"
 #include "QuantumComputation.hpp"
 #include "DDcomplex.h"
 #include "DDpackage.h"
 
+#include "Checkpoints.h"
+#include "Progress.h"
+#include "GateCache.h"
+#include "GCPolicy.h"
+#include "Marginals.h"
+#include "Sampler.h"
+#include "StateVector.h"
+#include "DDSerializer.h"
+#include "DDDiff.h"
+#include "ExportCache.h"
+#include "Layout.h"
+#include "LevelOfDetail.h"
+#include "PackagePool.h"
+#include "MemoryUsage.h"
+#include "CircuitCache.h"
+
 class QDDVis : public Napi::ObjectWrap<QDDVis> {
     public:
         static Napi::Object Init(Napi::Env evn, Napi::Object exports);
         explicit QDDVis(const Napi::CallbackInfo& info);
+        ~QDDVis() override;
 
     private:
         static Napi::FunctionReference constructor;
 
+        struct Measurement {    //outcome of one qubit of a measurement or reset
+            unsigned short qubit;
+            long cbit;          //-1 for resets
+            fp pzero;
+            fp pone;
+            char outcome;       //'0' or '1'
+        };
+
+        struct StepResult {     //plain result of a call, converted to a JS object on the main thread
+            long long numOfOperations = -1;
+            bool changed = false;
+            bool nextIsIrreversible = false;
+            bool noGoingBack = false;
+            bool barrier = false;
+            bool reset = false;
+            unsigned long long nops = 0;
+            bool conductIrreversibleOperation = false;  //Next stepped over a measurement or reset
+            Measurement parameter{0, -1, 0, 0, '0'};    //its first qubit, the client conducts it qubit by qubit
+            unsigned long long total = 0;               //number of qubits of the measurement or reset
+            bool cancelled = false;     //true if an asynchronous call stopped early (cancel() or timeout)
+        };
+
+        struct SubDD {          //the part of the state below a path from the root
+            std::string dot;    //normalized sub-DD, empty if the path has probability 0
+            fp re = 0, im = 0;  //weight the normalized sub-DD has to be multiplied with to get the part of the state
+            fp probability = 0; //probability of measuring the path
+        };
+
         //"private" methods
+        void releasePackage();
+        MemoryUsage measureMemory();
         void stepForward();
         void stepBack();
+        dd::Edge gateDD(bool inverse);
         std::pair<fp, fp> getProbabilities(unsigned short qubitIdx);
         void measureQubit(unsigned short qubitIdx, bool measureOne, fp pzero, fp pone);
+        std::vector<Measurement> measureRegister(const std::string* outcomes, unsigned long long seed);
+        bool restoreCheckpoint(unsigned int targetPos);
+        bool irreversibleBetween(unsigned int from, unsigned int to);
+        bool checkLoadArguments(const Napi::CallbackInfo& info);
+        void load(const std::string& algo, unsigned int formatCode, unsigned int opNum, bool process, StepResult& result,
+                  Progress* progress = nullptr);
+        void toStart(StepResult& result);
+        void prev(StepResult& result);
+        void next(StepResult& result);
+        void toEnd(StepResult& result, Progress* progress = nullptr);
+        void toLine(unsigned int targetPos, StepResult& result, Progress* progress = nullptr);
+        ExportCache::Dot exportDD();
+        ExportCache::Binary exportBinary();
+        SubDD exportSubDD(const std::string& path);
+        static fp squaredNorm(dd::NodePtr p, std::unordered_map<dd::NodePtr, fp>& memo);
+        std::unique_ptr<double[]> exportStateVector();
+        static Napi::Value wrapStateVector(Napi::Env env, std::unique_ptr<double[]>& amplitudes, unsigned short nqubits);
+        static Napi::Object loadState(Napi::Env env, const StepResult& result);
+        static Napi::Object prevState(Napi::Env env, const StepResult& result);
+        static Napi::Object nextState(Napi::Env env, const StepResult& result);
+        static Napi::Object endState(Napi::Env env, const StepResult& result);
+        static Napi::Object lineState(Napi::Env env, const StepResult& result);
+        static bool checkSampleArguments(const Napi::CallbackInfo& info, unsigned long long& shots, unsigned long long& seed);
+        static bool checkRegisterArguments(const Napi::CallbackInfo& info, std::string& outcomes, bool& draw,
+                                           unsigned long long& seed);
+        static Napi::Object registerState(Napi::Env env, const std::vector<Measurement>& results, bool nextIsIrreversible);
+        static Napi::Object subDDToObject(Napi::Env env, const SubDD& sub);
+        static Napi::Object histogramToObject(Napi::Env env, const Sampler::Histogram& histogram, unsigned short nqubits);
 
         //exported ("public") methods       - return type must be Napi::Value or void!
         Napi::Value Load(const Napi::CallbackInfo& info);
@@ -36,20 +114,63 @@ class QDDVis : public Napi::ObjectWrap<QDDVis> {
         Napi::Value IsReady(const Napi::CallbackInfo& info);
         void Unready(const Napi::CallbackInfo& info);
 		Napi::Value ConductIrreversibleOperation(const Napi::CallbackInfo& info);
+        //Promise-returning variants that do the work on the worker pool of the Scheduler
+        Napi::Value LoadAsync(const Napi::CallbackInfo& info);
+        Napi::Value ToStartAsync(const Napi::CallbackInfo& info);
+        Napi::Value PrevAsync(const Napi::CallbackInfo& info);
+        Napi::Value NextAsync(const Napi::CallbackInfo& info);
+        Napi::Value ToEndAsync(const Napi::CallbackInfo& info);
+        Napi::Value ToLineAsync(const Napi::CallbackInfo& info);
+        Napi::Value GetDDAsync(const Napi::CallbackInfo& info);
+        Napi::Value GetDDBinary(const Napi::CallbackInfo& info);
+        Napi::Value GetDDBinaryAsync(const Napi::CallbackInfo& info);
+        Napi::Value GetDDDiff(const Napi::CallbackInfo& info);
+        Napi::Value GetDDDiffAsync(const Napi::CallbackInfo& info);
+        Napi::Value GetLayout(const Napi::CallbackInfo& info);
+        Napi::Value GetLayoutAsync(const Napi::CallbackInfo& info);
+        Napi::Value GetDDSummary(const Napi::CallbackInfo& info);
+        Napi::Value GetDDSummaryAsync(const Napi::CallbackInfo& info);
+        Napi::Value GetSubDD(const Napi::CallbackInfo& info);
+        Napi::Value GetSubDDAsync(const Napi::CallbackInfo& info);
+        void Cancel(const Napi::CallbackInfo& info);
+        Napi::Value GetStats(const Napi::CallbackInfo& info);
+        void SetGCPolicy(const Napi::CallbackInfo& info);
+        Napi::Value GetProbabilities(const Napi::CallbackInfo& info);
+        Napi::Value Sample(const Napi::CallbackInfo& info);
+        Napi::Value SampleAsync(const Napi::CallbackInfo& info);
+        Napi::Value MeasureRegister(const Napi::CallbackInfo& info);
+        Napi::Value MeasureRegisterAsync(const Napi::CallbackInfo& info);
+        Napi::Value GetStateVector(const Napi::CallbackInfo& info);
+        Napi::Value GetStateVectorAsync(const Napi::CallbackInfo& info);
+        void Release(const Napi::CallbackInfo& info);
+        Napi::Value GetMemoryUsage(const Napi::CallbackInfo& info);
+        Napi::Value Compact(const Napi::CallbackInfo& info);
 
         //fields
-        std::unique_ptr<dd::Package> dd;
-        std::unique_ptr<qc::QuantumComputation> qc;
+        std::unique_ptr<dd::Package> dd;   //nullptr until the first load and after the package was released
+        CircuitCache::Circuit qc;   //shared with all sessions that loaded the same algorithm, hence never modified
         dd::Edge sim{};
 
-        std::vector<std::unique_ptr<qc::Operation>>::iterator iterator{};
+        std::vector<std::unique_ptr<qc::Operation>>::const_iterator iterator{};
         unsigned int position = 0;  //current position of the iterator
 
         std::array<short, qc::MAX_QUBITS> line {};
         std::bitset<qc::MAX_QUBITS> measurements{};
+        GCPolicy gc{};      //when the garbage collection runs while stepping
+        GateCache gates{};  //DDs of the operations, so stepping over the same operation again only costs the multiplication
+        Marginals marginals{};  //probabilities of all qubits, remembered for the last state they were computed for
+        Sampler sampler{};      //flattened copy of the last sampled state
+        DDDiff ddDiff{};        //the last DD exported via GetDDDiff
+        ExportCache exports{};  //serialized forms of the last exported states
+        Layout graphLayout{};   //positions of the last laid out DD
+        LevelOfDetail levelOfDetail{};  //ids and probabilities of the nodes of the last summarized DD
+        Checkpoints checkpoints{};  //sparse snapshots of sim for random access to any position
+        MemoryUsage memory{};   //last measured memory usage, reported while an asynchronous call is busy
         bool ready = false;     //true if a valid algorithm is imported, false otherwise
         bool atInitial = true; //whether we currently visualize the initial state or not
         bool atEnd = false; // whether we currently visualize the end of the given circuit
+        std::atomic<bool> busy{false};  //true while an asynchronous call is working on this object
+        std::atomic<unsigned int> cancelRequests{0};  //counted by Cancel, stops the asynchronous calls submitted before
 
         //options for the DD export
         bool showColors = true;
@@ -0,0 +1,131 @@
+
+#include <algorithm>
+#include <random>
+
+#include "Sampler.h"
+#include "Scheduler.h"
+
+/**
+ *
+ * @param dd the package the state belongs to
+ * @param state a vector DD (only e[0] and e[2] of its nodes are used)
+ * @param shots how many outcomes are drawn
+ * @param seed seed of the random generators, the same seed always leads to the same histogram for the same state
+ * @return how often every drawn outcome occurred (bit i of an outcome is the value of qubit i)
+ */
+Sampler::Histogram Sampler::sample(dd::Package& dd, const dd::Edge& state, unsigned long long shots,
+                                   unsigned long long seed) {
+    if(cached.p == nullptr || !dd::Package::equals(cached, state)) {
+        clear(dd);
+        if(!dd::Package::isTerminal(state)) {
+            int root = -1;
+            flatten(dd::Edge{state.p, CN::ONE}, root);
+            visited.clear();
+        }
+        cached = state;
+        dd.incRef(cached);
+    }
+
+    Histogram histogram;
+    if(shots == 0) return histogram;
+    if(nodes.empty()) {     //no qubits, so there is only one outcome
+        histogram[Outcome{}] = shots;
+        return histogram;
+    }
+
+    const unsigned long long chunks = (shots + SHOTS_PER_CHUNK - 1) / SHOTS_PER_CHUNK;
+    const unsigned long long threads = std::min<unsigned long long>(
+            {chunks, MAX_THREADS, std::max<std::size_t>(1, Scheduler::get().getWorkers())});
+    if(threads <= 1) {
+        sampleChunks(shots, seed, 0, 1, histogram);
+        return histogram;
+    }
+
+    //task t takes every threads-th chunk and fills its own histogram, which are merged afterwards
+    std::vector<Histogram> partial(threads);
+    Scheduler::get().parallelFor(threads, [&](std::size_t t) {
+        sampleChunks(shots, seed, t, threads, partial[t]);
+    });
+
+    for(const auto& part : partial) {
+        for(const auto& entry : part) histogram[entry.first] += entry.second;
+    }
+    return histogram;
+}
+
+/**Forgets the flattened state, e.g. before the package is reset.
+ *
+ * @param dd the package the remembered state belongs to
+ */
+void Sampler::clear(dd::Package& dd) {
+    if(cached.p != nullptr) dd.decRef(cached);
+    cached = dd::Edge{};
+    nodes.clear();
+    nodes.shrink_to_fit();
+}
+
+/**Appends the node of the given edge and all nodes below it to nodes (each node only once).
+ *
+ * @param edge a non-zero edge
+ * @param flatIndex is set to the index of the node of edge in nodes or -1 if edge points to the terminal
+ * @return squared norm of the sub-vector edge represents
+ */
+fp Sampler::flatten(const dd::Edge& edge, int& flatIndex) {
+    if(dd::Package::isTerminal(edge)) {
+        flatIndex = -1;
+        return CN::mag2(edge.w);
+    }
+    auto it = visited.find(edge.p);
+    if(it != visited.end()) {
+        flatIndex = it->second.first;
+        return CN::mag2(edge.w) * it->second.second;
+    }
+
+    flatIndex = (int)nodes.size();
+    nodes.push_back(FlatNode{edge.p->v, {-1, -1}, 0});  //reserve the slot, so parents come before their children
+
+    fp norm[2] = {0, 0};
+    int child[2] = {-1, -1};
+    for(int i = 0; i < 2; i++) {
+        const dd::Edge& e = edge.p->e[2 * i];
+        if(!CN::equalsZero(e.w)) norm[i] = flatten(e, child[i]);
+    }
+    const fp down = norm[0] + norm[1];
+
+    FlatNode& node = nodes[flatIndex];
+    node.child[0] = child[0];
+    node.child[1] = child[1];
+    node.pzero = down > 0 ? norm[0] / down : 1;
+    visited.emplace(edge.p, std::make_pair(flatIndex, down));
+    return CN::mag2(edge.w) * down;
+}
+
+/**Draws the shots of the chunks firstChunk, firstChunk + chunkStep, ... into the given histogram.
+ *
+ * @param shots number of shots of all chunks together
+ * @param seed seed of the whole sampling
+ * @param firstChunk the first chunk to draw
+ * @param chunkStep distance to the next chunk to draw
+ * @param histogram is filled with the drawn outcomes
+ */
+void Sampler::sampleChunks(unsigned long long shots, unsigned long long seed, unsigned long long firstChunk,
+                           unsigned long long chunkStep, Histogram& histogram) const {
+    std::uniform_real_distribution<fp> dist(0.0, 1.0);
+    for(unsigned long long chunk = firstChunk; chunk * SHOTS_PER_CHUNK < shots; chunk += chunkStep) {
+        std::seed_seq seq{(unsigned int)seed, (unsigned int)(seed >> 32u), (unsigned int)chunk, (unsigned int)(chunk >> 32u)};
+        std::mt19937_64 rng(seq);
+
+        const unsigned long long end = std::min(shots, (chunk + 1) * SHOTS_PER_CHUNK);
+        for(unsigned long long shot = chunk * SHOTS_PER_CHUNK; shot < end; shot++) {
+            Outcome outcome;
+            int i = 0;
+            while(i >= 0) {
+                const FlatNode& node = nodes[i];
+                const int bit = dist(rng) >= node.pzero ? 1 : 0;
+                if(bit) outcome.set(node.level);
+                i = node.child[bit];
+            }
+            ++histogram[outcome];
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef QDD_VIS_SAMPLER_H
+#define QDD_VIS_SAMPLER_H
+
+#include <bitset>
+#include <unordered_map>
+#include <vector>
+
+#include "operations/Operation.hpp"
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Draws measurement outcomes of all qubits from a vector DD without collapsing it. The DD is flattened once into an
+ * array that stores for every node the probability of taking its 0-edge (derived from the squared norms below its
+ * children), so every shot is a single root-to-terminal walk. The flattened DD is kept for the last sampled state,
+ * which is ref-counted meanwhile.
+ * The shots are split into chunks with their own random generator seeded by (seed, chunk), so the histogram only
+ * depends on the seed and not on how many threads worked on the chunks. The chunks are split into up to MAX_THREADS
+ * tasks, which run on idle workers of the Scheduler (see Scheduler::parallelFor).
+ */
+class Sampler {
+public:
+    using Outcome = std::bitset<qc::MAX_QUBITS>;
+    using Histogram = std::unordered_map<Outcome, unsigned long long>;
+
+    static constexpr unsigned long long SHOTS_PER_CHUNK = 1u << 14;
+    static constexpr unsigned int MAX_THREADS = 8;
+
+    Histogram sample(dd::Package& dd, const dd::Edge& state, unsigned long long shots, unsigned long long seed);
+    void clear(dd::Package& dd);
+    std::size_t getBytes() const { return nodes.capacity() * sizeof(FlatNode); }
+
+private:
+    struct FlatNode {
+        short level;
+        int child[2];   //index of the node the 0-/1-edge points to, -1 for the terminal
+        fp pzero;       //probability of taking the 0-edge
+    };
+
+    fp flatten(const dd::Edge& edge, int& flatIndex);
+    void sampleChunks(unsigned long long shots, unsigned long long seed, unsigned long long firstChunk,
+                      unsigned long long chunkStep, Histogram& histogram) const;
+
+    dd::Edge cached{};      //the state that is flattened in nodes, nullptr if there is none
+    std::vector<FlatNode> nodes{};  //the root is at index 0
+    std::unordered_map<dd::NodePtr, std::pair<int, fp>> visited{};  //scratch: flat index and squared norm per node
+};
+
+#endif //QDD_VIS_SAMPLER_H
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "Scheduler.h"
+
+/**The scheduler is created on first use with one worker per hardware thread, unless the environment variable
+ * QDD_WORKERS says otherwise. It is never destroyed, so its workers live as long as the process.
+ *
+ * @return the scheduler of the process
+ */
+Scheduler& Scheduler::get() {
+    static Scheduler* scheduler = [] {
+        unsigned int numWorkers = std::thread::hardware_concurrency();
+        const char* env = std::getenv("QDD_WORKERS");
+        if(env != nullptr && std::atoi(env) > 0) numWorkers = (unsigned int)std::atoi(env);
+        return new Scheduler(numWorkers > 0 ? numWorkers : 1);
+    }();
+    return *scheduler;
+}
+
+Scheduler::Scheduler(unsigned int numWorkers) {
+    workers.reserve(numWorkers);
+    for(unsigned int i = 0; i < numWorkers; i++) {
+        workers.emplace_back(&Scheduler::work, this);
+        workers.back().detach();
+    }
+}
+
+/**Queues work on the given strand.
+ *
+ * @param strand identifies the session the work belongs to
+ * @param work the work to run on a worker thread
+ * @return false if the work wasn't queued because the strand or the scheduler has too much pending work
+ */
+bool Scheduler::submit(const void* strand, Work work) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Strand& s = strands[strand];
+    if(pending >= MAX_PENDING || s.pending >= MAX_PENDING_PER_STRAND) {
+        if(s.pending == 0) strands.erase(strand);
+        return false;
+    }
+
+    s.queue.push_back(std::move(work));
+    s.pending++;
+    pending++;
+    if(!s.active) {
+        s.active = true;
+        ready.push_back(strand);
+        available.notify_one();
+    }
+    return true;
+}
+
+/**Has to be called once for every call that was run, after its result has been processed. Only then the next call of
+ * the strand can start.
+ *
+ * @param strand the strand of the call
+ */
+void Scheduler::finished(const void* strand) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending--;
+    auto it = strands.find(strand);
+    if(it == strands.end()) return;
+    it->second.pending--;
+    if(it->second.queue.empty()) {
+        strands.erase(it);
+    } else {
+        ready.push_back(strand);    //goes to the end of the line, so other sessions take their turn first
+        available.notify_one();
+    }
+}
+
+/**Runs task(0), ..., task(count - 1) and returns once all of them are done. The calling thread takes tasks itself
+ * and is only helped by workers that are idle right now, so a call that runs on a worker doesn't wait for another
+ * call to finish, and nothing is left behind if no worker is free: helpers that only start after the caller ran out
+ * of tasks return immediately. The tasks may run in any order and on any number of threads.
+ *
+ * @param count number of tasks
+ * @param task the work of one task, gets its index
+ */
+void Scheduler::parallelFor(std::size_t count, const Task& task) {
+    auto fork = std::make_shared<Fork>();
+    fork->task = &task;
+    fork->count = count;
+
+    if(count > 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::size_t idle = workers.size() - std::min(workers.size(), busy + helpers.size());
+        const std::size_t numHelpers = std::min(count - 1, idle);
+        for(std::size_t i = 0; i < numHelpers; i++) {
+            helpers.emplace_back([fork] {
+                {
+                    std::lock_guard<std::mutex> forkLock(fork->mutex);
+                    if(fork->closed) return;
+                    fork->helping++;
+                }
+                runTasks(*fork);
+                std::lock_guard<std::mutex> forkLock(fork->mutex);
+                fork->helping--;
+                fork->joined.notify_all();
+            });
+        }
+        if(numHelpers > 0) available.notify_all();
+    }
+
+    runTasks(*fork);
+    std::unique_lock<std::mutex> forkLock(fork->mutex);
+    fork->closed = true;
+    fork->joined.wait(forkLock, [&fork] { return fork->helping == 0; });
+}
+
+void Scheduler::runTasks(Fork& fork) {
+    for(std::size_t i = fork.next++; i < fork.count; i = fork.next++) (*fork.task)(i);
+}
+
+/**
+ *
+ * @return number of calls that are queued or running
+ */
+std::size_t Scheduler::getPending() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
+
+void Scheduler::work() {
+    while(true) {
+        Work next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return !ready.empty() || !helpers.empty(); });
+            if(!helpers.empty()) {
+                next = std::move(helpers.front());
+                helpers.pop_front();
+            } else {
+                const void* strand = ready.front();
+                ready.pop_front();
+                Strand& s = strands[strand];
+                next = std::move(s.queue.front());
+                s.queue.pop_front();
+            }
+            busy++;
+        }
+        next();
+        std::lock_guard<std::mutex> lock(mutex);
+        busy--;
+    }
+}
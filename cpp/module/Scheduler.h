@@ -0,0 +1,73 @@
+#ifndef QDD_VIS_SCHEDULER_H
+#define QDD_VIS_SCHEDULER_H
+
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**Process-wide pool of worker threads that runs the asynchronous calls of all sessions. Work is queued per strand (one
+ * strand per QDDVis/QDDVer object), so calls of the same session never run at the same time and are processed in the
+ * order they were submitted, while different sessions run in parallel on all workers. Strands with pending work take
+ * turns (one call each), so a session that queued many calls can't starve the others.
+ * A strand stays occupied until finished() is called for its running call, which allows the result to be converted on
+ * the main thread before the next call of the same session starts. If too much work is pending, submit() refuses
+ * further calls instead of queueing them (backpressure).
+ * A running call can split its own work with parallelFor(), which lends it idle workers (fork/join) instead of
+ * starting threads of its own, so the process never runs more threads than the pool has.
+ */
+class Scheduler {
+public:
+    using Work = std::function<void()>;     //runs on a worker thread, must not throw
+    using Task = std::function<void(std::size_t)>;  //gets the index of the task, must not throw
+
+    static constexpr std::size_t MAX_PENDING_PER_STRAND = 8;    //queued and running calls of one session
+    static constexpr std::size_t MAX_PENDING = 1024;            //queued and running calls of all sessions together
+
+    static Scheduler& get();
+
+    bool submit(const void* strand, Work work);
+    void finished(const void* strand);
+    void parallelFor(std::size_t count, const Task& task);
+
+    std::size_t getWorkers() const { return workers.size(); }
+    std::size_t getPending();
+
+private:
+    struct Strand {
+        std::deque<Work> queue{};
+        std::size_t pending = 0;    //queued calls and the running one
+        bool active = false;        //true while the strand waits for a worker or one of its calls is running
+    };
+
+    struct Fork {
+        const Task* task = nullptr;
+        std::size_t count = 0;
+        std::atomic<std::size_t> next{0};   //index of the next task that isn't taken yet
+        std::mutex mutex;
+        std::condition_variable joined;
+        std::size_t helping = 0;            //workers that are currently taking tasks of this fork
+        bool closed = false;                //set once the caller ran out of tasks, later helpers have nothing to do
+    };
+
+    explicit Scheduler(unsigned int numWorkers);
+    static void runTasks(Fork& fork);
+    void work();
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::unordered_map<const void*, Strand> strands{};
+    std::deque<const void*> ready{};    //strands with queued work whose previous call is finished, in turn order
+    std::deque<Work> helpers{};         //lent to parallelFor, run before the next call of any strand
+    std::size_t pending = 0;
+    std::size_t busy = 0;               //workers that are running a call or helping
+    std::vector<std::thread> workers{};
+};
+
+#endif //QDD_VIS_SCHEDULER_H
@@ -0,0 +1,57 @@
+
+#include "StateVector.h"
+
+/**
+ *
+ * @param state a vector DD (only e[0] and e[2] of its nodes are used)
+ * @param nqubits number of qubits of the state (at most MAX_QUBITS)
+ * @param out zero-initialized memory for 2 * 2^nqubits doubles, amplitude i is stored at out[2i] (re) and out[2i+1] (im)
+ */
+void StateVector::expand(const dd::Edge& state, unsigned short nqubits, double* out) {
+    if(CN::equalsZero(state.w)) return;
+    StateVector expansion(out);
+    expansion.expand(state, 1, 0, (short)(nqubits - 1), 0);
+}
+
+/**Writes the sub-vector of the given edge scaled by (re + i*im) to the amplitudes offset, ..., offset + 2^(level+1) - 1.
+ *
+ * @param edge a non-zero edge
+ * @param re real part of the weight accumulated above edge
+ * @param im imaginary part of the weight accumulated above edge
+ * @param level the level of the node edge points to (-1 for the terminal)
+ * @param offset index of the first amplitude of the sub-vector
+ */
+void StateVector::expand(const dd::Edge& edge, double re, double im, short level, std::size_t offset) {
+    const double wr = CN::val(edge.w.r);
+    const double wi = CN::val(edge.w.i);
+    const double r = re * wr - im * wi;
+    const double i = re * wi + im * wr;
+
+    if(dd::Package::isTerminal(edge)) {
+        out[2 * offset] = r;
+        out[2 * offset + 1] = i;
+        return;
+    }
+
+    const std::size_t size = std::size_t{1} << (level + 1);
+    auto it = expanded.find(edge.p);
+    if(it != expanded.end() && it->second.re * it->second.re + it->second.im * it->second.im > 0) {
+        //the same node was already expanded with the weight (b.re + i*b.im), so we only need to rescale the copy
+        const Block& b = it->second;
+        const double norm = b.re * b.re + b.im * b.im;
+        const double fr = (r * b.re + i * b.im) / norm;
+        const double fi = (i * b.re - r * b.im) / norm;
+        const double* src = out + 2 * b.offset;
+        double* dst = out + 2 * offset;
+        for(std::size_t k = 0; k < size; k++) {
+            dst[2 * k] = src[2 * k] * fr - src[2 * k + 1] * fi;
+            dst[2 * k + 1] = src[2 * k] * fi + src[2 * k + 1] * fr;
+        }
+        return;
+    }
+
+    const std::size_t half = size / 2;
+    if(!CN::equalsZero(edge.p->e[0].w)) expand(edge.p->e[0], r, i, (short)(level - 1), offset);
+    if(!CN::equalsZero(edge.p->e[2].w)) expand(edge.p->e[2], r, i, (short)(level - 1), offset + half);
+    expanded.emplace(edge.p, Block{offset, r, i});
+}
@@ -0,0 +1,33 @@
+#ifndef QDD_VIS_STATEVECTOR_H
+#define QDD_VIS_STATEVECTOR_H
+
+#include <cstddef>
+#include <unordered_map>
+
+#include "DDcomplex.h"
+#include "DDpackage.h"
+
+/**Expands a vector DD into its dense amplitude vector (interleaved real and imaginary parts). Every node is only
+ * expanded once: when it is reached again, the block it was expanded to is copied and rescaled by the ratio of the two
+ * accumulated edge weights, so shared subtrees cost a copy instead of another traversal.
+ */
+class StateVector {
+public:
+    static constexpr unsigned short MAX_QUBITS = 25;    //2^25 amplitudes already need 512 MiB
+
+    static void expand(const dd::Edge& state, unsigned short nqubits, double* out);
+
+private:
+    struct Block {
+        std::size_t offset;     //index of the first amplitude the node was expanded to
+        double re, im;          //accumulated weight the block was scaled with
+    };
+
+    StateVector(double* out) : out(out) {}
+    void expand(const dd::Edge& edge, double re, double im, short level, std::size_t offset);
+
+    double* out;
+    std::unordered_map<dd::NodePtr, Block> expanded{};
+};
+
+#endif //QDD_VIS_STATEVECTOR_H
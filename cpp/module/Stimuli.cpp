@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "Stimuli.h"
+#include "PackagePool.h"
+#include "Scheduler.h"
+
+/**Reads the options of the pre-check and throws an error if they are invalid.
+ *
+ * @param env the environment of the call
+ * @param options the options object of the call (see the class description), may be undefined
+ * @param result is set to the given options, count stays 0 if no stimuli are requested
+ * @return true if the options are valid, false otherwise
+ */
+bool Stimuli::parseOptions(Napi::Env env, const Napi::Value& options, Options& result) {
+    result = Options{};
+    result.seed = std::random_device{}();
+    if(!options.IsObject()) return true;
+    Napi::Object obj = options.As<Napi::Object>();
+
+    if(obj.Has("stimuli")) {
+        if(!obj.Get("stimuli").IsNumber()) {
+            Napi::TypeError::New(env, "stimuli: unsigned int expected!").ThrowAsJavaScriptException();
+            return false;
+        }
+        const long long count = obj.Get("stimuli").As<Napi::Number>().Int64Value();
+        result.count = (unsigned int)std::max(0LL, std::min((long long)MAX_STIMULI, count));
+    }
+    if(obj.Has("stimuliType")) {
+        const Napi::Value type = obj.Get("stimuliType");
+        const std::string name = type.IsString() ? type.As<Napi::String>().Utf8Value() : "";
+        if(name == "basis")         result.type = Type::Basis;
+        else if(name == "product")  result.type = Type::Product;
+        else {
+            Napi::Error::New(env, "stimuliType: \"basis\" or \"product\" expected!").ThrowAsJavaScriptException();
+            return false;
+        }
+    }
+    if(obj.Has("seed") && obj.Get("seed").IsNumber()) {
+        result.seed = (unsigned long long)obj.Get("seed").As<Napi::Number>().Int64Value();
+    }
+    return true;
+}
+
+/**Simulates both algorithms on the stimuli until all of them are done or the outputs for one of them differ. Doesn't
+ * use any N-API objects, so it can (and should) be called from a worker thread.
+ *
+ * @param qc1 the first algorithm
+ * @param qc2 the second algorithm, it needs to have the same number of qubits
+ * @param options number, type and seed of the stimuli
+ * @param result is filled with the outcome of the pre-check
+ * @param progress if not nullptr, stops the pre-check after the stimuli that are currently simulated once it says so
+ * @throws the exception of the first stimulus whose simulation failed
+ */
+void Stimuli::run(const qc::QuantumComputation& qc1, const qc::QuantumComputation& qc2, const Options& options,
+                  Result& result, const Progress* progress) {
+    const auto start = std::chrono::steady_clock::now();
+    const unsigned int count = std::min(options.count, MAX_STIMULI);
+    const unsigned short nqubits = qc1.getNqubits();
+    std::vector<bool> ancillae(nqubits, false);     //qubits that stay |0> in every stimulus
+    for(unsigned short q = 0; q < nqubits; q++) {
+        ancillae[q] = (q < qc1.ancillary.size() && qc1.ancillary[q]) || (q < qc2.ancillary.size() && qc2.ancillary[q]);
+    }
+
+    std::atomic<unsigned int> next{0};      //index of the next stimulus that isn't taken by a thread yet
+    std::atomic<unsigned int> simulated{0};
+    std::atomic<bool> stop{false};          //set as soon as the result is known (or a simulation failed)
+    std::mutex mutex;                       //guards result and error
+    std::exception_ptr error = nullptr;
+
+    auto work = [&](std::size_t) {
+        std::unique_ptr<dd::Package> dd;
+        try {
+            dd = PackagePool::acquire(dd::Vector);
+            for(unsigned int i = next++; i < count && !stop && (progress == nullptr || !progress->shouldStop()); i = next++) {
+                std::mt19937_64 rng(options.seed + i);
+                std::string input;
+                dd::Edge in = prepare(*dd, ancillae, options.type, rng, input);
+                dd->incRef(in);
+                dd::Edge out1 = simulate(dd, qc1, in);
+                dd::Edge out2 = simulate(dd, qc2, in);
+                const fp fidelity = dd->fidelity(out1, out2);
+                dd->decRef(in);
+                dd->decRef(out1);
+                dd->decRef(out2);
+                dd->garbageCollect();
+                ++simulated;
+
+                if(fidelity < 1 - TOLERANCE) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(!result.differ || (long long)i < result.stimulus) {
+                        result.differ = true;
+                        result.stimulus = i;
+                        result.input = input;
+                        result.fidelity = fidelity;
+                    }
+                    stop = true;
+                }
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!error) error = std::current_exception();
+            stop = true;
+            dd.reset();     //it may still hold references, so it can't go back to the pool
+        }
+        if(dd) PackagePool::release(std::move(dd));
+    };
+
+    //every task takes stimuli until none are left, so tasks that only start late (or never get a worker) cost nothing
+    Scheduler::get().parallelFor(std::min<std::size_t>(count, Scheduler::get().getWorkers()), work);
+    if(error) std::rethrow_exception(error);
+
+    result.simulated = simulated;
+    result.cancelled = !result.differ && simulated < count;
+    result.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ *
+ * @param env the environment the object is created in
+ * @param result the result of run
+ * @return object with members simulated, differ, stimulus (-1 if the outputs never differed), input (only for basis
+ *          states), fidelity, time (in µs) and cancelled
+ */
+Napi::Object Stimuli::toObject(Napi::Env env, const Result& result) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("simulated", Napi::Number::New(env, result.simulated));
+    obj.Set("differ", Napi::Boolean::New(env, result.differ));
+    obj.Set("stimulus", Napi::Number::New(env, result.stimulus));
+    if(!result.input.empty()) obj.Set("input", Napi::String::New(env, result.input));
+    obj.Set("fidelity", Napi::Number::New(env, result.fidelity));
+    obj.Set("time", Napi::Number::New(env, result.time));
+    obj.Set("cancelled", Napi::Boolean::New(env, result.cancelled));
+    return obj;
+}
+
+/**Draws a random input state. Ancillary qubits are left in |0>, because the matrix check only considers this input
+ * for them (the identity it starts with is reduced by the ancillae).
+ *
+ * @param dd the package the state is created in (in vector mode)
+ * @param ancillae one entry per qubit of the state, true if the qubit is ancillary in one of the algorithms
+ * @param type whether a basis state or a product state is drawn
+ * @param rng the generator of this stimulus
+ * @param input is set to the basis state, the most significant qubit first (stays empty for product states)
+ * @return the input state (not ref-counted)
+ */
+dd::Edge Stimuli::prepare(dd::Package& dd, const std::vector<bool>& ancillae, Type type, std::mt19937_64& rng,
+                          std::string& input) {
+    const auto nqubits = static_cast<unsigned short>(ancillae.size());
+    std::array<short, qc::MAX_QUBITS> line{};
+    dd::Edge state = dd.makeZeroState(nqubits);
+    if(type == Type::Basis) input.assign(nqubits, '0');
+
+    std::uniform_real_distribution<fp> uniform(0, 1);
+    for(unsigned short q = 0; q < nqubits; q++) {
+        if(ancillae[q]) continue;
+        dd::Matrix2x2 gate{
+                {{1, 0}, {0, 0}},
+                {{0, 0}, {1, 0}}
+        };
+        if(type == Type::Basis) {
+            if(rng() % 2 == 0) continue;    //the qubit stays |0>
+            gate[0][0] = {0, 0};    //X
+            gate[0][1] = {1, 0};
+            gate[1][0] = {1, 0};
+            gate[1][1] = {0, 0};
+            input[nqubits - 1 - q] = '1';
+        } else {
+            //uniformly distributed on the Bloch sphere: cos(theta/2)|0> + e^(i*phi)*sin(theta/2)|1>
+            const fp theta = std::acos(1 - 2 * uniform(rng));
+            const fp phi = 2 * std::acos(fp(-1)) * uniform(rng);
+            const fp c = std::cos(theta / 2), s = std::sin(theta / 2);
+            gate[0][0] = {c, 0};
+            gate[0][1] = {-s, 0};
+            gate[1][0] = {std::cos(phi) * s, std::sin(phi) * s};
+            gate[1][1] = {std::cos(phi) * c, std::sin(phi) * c};
+        }
+
+        line.fill(qc::LINE_DEFAULT);
+        line[q] = 2;
+        state = dd.multiply(dd.makeGateDD(gate, nqubits, line.data()), state);
+    }
+    return state;
+}
+
+/**Applies all operations of an algorithm to a state.
+ *
+ * @param dd the package the state belongs to (in vector mode)
+ * @param qc the algorithm
+ * @param state the input state
+ * @return the output state (ref-counted)
+ */
+dd::Edge Stimuli::simulate(std::unique_ptr<dd::Package>& dd, const qc::QuantumComputation& qc, dd::Edge state) {
+    std::array<short, qc::MAX_QUBITS> line{};
+    line.fill(qc::LINE_DEFAULT);
+    qc::permutationMap map = qc.initialLayout;
+
+    dd->incRef(state);
+    for(const auto& op : qc) {
+        const dd::Edge gate = op->getDD(dd, line, map);
+        dd::Edge temp = dd->multiply(gate, state);
+        dd->incRef(temp);
+        dd->decRef(state);
+        state = temp;
+        dd->garbageCollect();
+    }
+    return state;
+}
@@ -0,0 +1,64 @@
+#ifndef QDD_VIS_STIMULI_H
+#define QDD_VIS_STIMULI_H
+
+#include <napi.h>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "QuantumComputation.hpp"
+#include "DDcomplex.h"
+#include "DDpackage.h"
+#include "Progress.h"
+
+/**Pre-check of the equivalence check of QDDVer: both algorithms are simulated on a few random input states, which
+ * only needs state vectors instead of the matrix of the whole algorithm. Most non-equivalent algorithms already
+ * produce different outputs for one of them, only if all outputs agree the (much more expensive) matrix check is
+ * needed. The stimuli are distributed over idle workers of the Scheduler (see Scheduler::parallelFor), each with its
+ * own dd::Package from the PackagePool in vector mode. Stimulus i is always drawn from a generator seeded by seed + i, so the result doesn't depend on the
+ * number of threads. Ancillary qubits (of either algorithm) always start in |0>, just like the matrix check only
+ * considers that input for them, so the pre-check never finds a difference the matrix check wouldn't.
+ *
+ * Options (all optional): { stimuli: number of random inputs (0 = no pre-check), stimuliType: "basis" or "product",
+ *                           seed: unsigned int }
+ */
+class Stimuli {
+public:
+    enum class Type {
+        Basis,      //random computational basis states
+        Product     //random single-qubit states on every qubit
+    };
+
+    struct Options {
+        unsigned int count = 0;
+        Type type = Type::Basis;
+        unsigned long long seed = 0;
+    };
+
+    struct Result {
+        unsigned int simulated = 0;     //number of stimuli both algorithms were simulated on
+        bool differ = false;            //whether the outputs differed for one of them
+        long long stimulus = -1;        //index of the (first found) stimulus with different outputs
+        std::string input;              //the stimulus as basis state (only for Type::Basis)
+        fp fidelity = 1;                //fidelity of the two outputs for this stimulus
+        long long time = 0;             //in µs
+        bool cancelled = false;
+    };
+
+    static constexpr unsigned int MAX_STIMULI = 1024;
+    static constexpr fp TOLERANCE = 1e-8;   //outputs with a fidelity closer to 1 than this are considered equal
+
+    static bool parseOptions(Napi::Env env, const Napi::Value& options, Options& result);
+    static void run(const qc::QuantumComputation& qc1, const qc::QuantumComputation& qc2, const Options& options,
+                    Result& result, const Progress* progress = nullptr);
+    static Napi::Object toObject(Napi::Env env, const Result& result);
+
+private:
+    static dd::Edge prepare(dd::Package& dd, const std::vector<bool>& ancillae, Type type, std::mt19937_64& rng,
+                            std::string& input);
+    static dd::Edge simulate(std::unique_ptr<dd::Package>& dd, const qc::QuantumComputation& qc, dd::Edge state);
+};
+
+#endif //QDD_VIS_STIMULI_H
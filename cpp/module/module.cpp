@@ -2,10 +2,48 @@
 #include <napi.h>
 #include "QDDVis.h"
 #include "QDDVer.h"
+#include "PackagePool.h"
+#include "CircuitCache.h"
+
+/**Parses an algorithm ahead of time and keeps it in the CircuitCache, so loading it later is only a lookup. Used for
+ * the example algorithms when the server starts.
+ *
+ * @param info takes two parameters
+ *              string: the algorithm
+ *              unsigned int: format code of the algorithm (1 = QASM, 2 = Real)
+ * @return whether the algorithm could be parsed
+ */
+Napi::Value PreloadCircuit(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if(info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "String and Number expected!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    const std::string algo = info[0].As<Napi::String>().Utf8Value();
+    const unsigned int formatCode = (unsigned int)info[1].As<Napi::Number>();
+
+    qc::Format format;
+    if(formatCode == 1)         format = qc::OpenQASM;
+    else if(formatCode == 2)    format = qc::Real;
+    else {
+        Napi::Error::New(env, "Invalid format-code!").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    try {
+        CircuitCache::preload(algo, format);
+    } catch(std::exception& e) {
+        std::cout << "Exception while preloading an algorithm: " << e.what() << std::endl;
+        return Napi::Boolean::New(env, false);
+    }
+    return Napi::Boolean::New(env, true);
+}
 
 Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
     exports = QDDVis::Init(env, exports);
     exports = QDDVer::Init(env, exports);
+    PackagePool::warmUp(PackagePool::WARM_PACKAGES);   //so the first load doesn't have to allocate the tables
+    exports.Set("preloadCircuit", Napi::Function::New(env, PreloadCircuit));
     return exports;
   //return QDDVis::Init(env, exports);
 }
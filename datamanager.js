@@ -137,6 +137,7 @@ function get(req) {
 //external scripts may only register/create and request/get objects
 module.exports.register = register;
 module.exports.get = get;
+module.exports.enforceMemoryBudget = enforceMemoryBudget;
 //allowing external removing may also make sense, but this isn't needed at the moment
 
 const CLEANUP_TIMER = 24 * 60 * 60 * 1000;   //how much time passes between two cleanUPData()-calls - in ms (24 hours at the moment)
@@ -163,8 +164,15 @@ function _cleanUpData() {
             }
         }
 
-        //remove all "old" entries
-        for(const key of keysToRemove) dm.data.delete(key);
+        //remove all "old" entries, their dd::Packages go back to the native pool
+        for(const key of keysToRemove) {
+            try {
+                dm.data.get(key).vis.release();
+            } catch(err) {  //still busy, the package is returned when the object is collected
+                console.log("Couldn't release " + key + ": " + err.message);
+            }
+            dm.data.delete(key);
+        }
     }
 
 
@@ -173,4 +181,89 @@ function _cleanUpData() {
 }
 //initiate the future cleanup
 setTimeout(() => _cleanUpData(), CLEANUP_TIMER);
+
+
+const MEMORY_BUDGET = Number(process.env.QDD_MEMORY_BUDGET) || 2 * 1024 * 1024 * 1024;  //how many bytes the native
+                                                                // objects of all sessions together may use (estimated)
+const MEMORY_CHECK_TIMER = 60 * 1000;               //how much time passes between two budget checks - in ms
+const MIN_IDLE_TIME = 5 * 60 * 1000;                //sessions accessed less than this many ms ago are never evicted
+const HEAVY_SESSION_BYTES = MEMORY_BUDGET / 32;     //sessions using at least this many bytes are evicted first
+
+/**Retrieves the estimated memory usage of every native object.
+ *
+ * @returns {Array} of {dm, key, item, bytes} sorted by last_access (least recently used first)
+ * @private
+ */
+function _collectMemoryUsage() {
+    const sessions = [];
+    for(const entry of manager.entries()) {     //entry: [key, value]
+        const dm = entry[1];
+        for(const item of dm.data.entries()) {  //item: [key, value]
+            const usage = item[1].vis.memoryUsage();
+            sessions.push({ dm: dm, key: item[0], item: item[1], bytes: usage.bytes, busy: usage.busy });
+        }
+    }
+    sessions.sort((a, b) => a.item.last_access - b.item.last_access);
+    return sessions;
+}
+
+/**Keeps the estimated memory usage of all sessions below MEMORY_BUDGET. First the least recently used sessions are
+ * compacted (their caches are dropped, but they keep their state). If that isn't enough, the least recently used heavy
+ * sessions are removed, followed by the remaining ones, except those that were accessed in the last MIN_IDLE_TIME ms.
+ * Sessions that are busy are skipped.
+ * Logs how much memory was freed and how many sessions were removed.
+ */
+function enforceMemoryBudget() {
+    const sessions = _collectMemoryUsage();
+    let total = sessions.reduce((sum, s) => sum + s.bytes, 0);
+    if(total <= MEMORY_BUDGET) return;
+
+    const before = total;
+    for(const s of sessions) {
+        if(total <= MEMORY_BUDGET) break;
+        if(s.busy) continue;
+        try {
+            const freed = s.item.vis.compact();
+            s.bytes -= freed;
+            total -= freed;
+        } catch(err) {  //started working meanwhile
+            s.busy = true;
+        }
+    }
+
+    const minLA = _getTimeStamp() - MIN_IDLE_TIME;
+    let removed = 0;
+    const evict = (s) => {
+        try {
+            s.item.vis.release();
+        } catch(err) {  //still busy, keep it
+            return;
+        }
+        s.dm.data.delete(s.key);
+        total -= s.bytes;
+        s.bytes = 0;
+        removed++;
+    };
+    for(const heavyOnly of [true, false]) {
+        for(const s of sessions) {
+            if(total <= MEMORY_BUDGET) break;
+            if(s.busy || s.bytes === 0 || s.item.last_access >= minLA) continue;
+            if(heavyOnly && s.bytes < HEAVY_SESSION_BYTES) continue;
+            evict(s);
+        }
+    }
+
+    console.log("Memory budget: freed " + (before - total) + " bytes, removed " + removed + " sessions, " +
+        total + " of " + MEMORY_BUDGET + " bytes in use.");
+}
+
+/**Checks the memory budget periodically, since stepping through an algorithm may also let a session grow.
+ *
+ * @private
+ */
+function _checkMemoryBudget() {
+    enforceMemoryBudget();
+    setTimeout(() => _checkMemoryBudget(), MEMORY_CHECK_TIMER);
+}
+setTimeout(() => _checkMemoryBudget(), MEMORY_CHECK_TIMER);
 //no initial cleanup needed since data has just been assigned to new Map()
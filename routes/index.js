@@ -3,6 +3,20 @@ const fs = require('fs');
 const express = require('express');
 const router = express.Router();
 const dm = require('../datamanager');
+const qddVis = require('../build/Release/QDD_Vis');
+
+const SIMULATION_TIMEOUT = 60 * 1000;   //ms after which a long-running simulation stops at its last applied operation
+const lastProgress = new WeakMap();     //the latest progress event of the currently running call per QDDVis-object
+
+/**Creates the options for the async calls of the given object: a timeout and a callback that stores the latest
+ * progress event, so it can be polled via /progress.
+ *
+ * @param vis the QDDVis- or QDDVer-object the call is made on
+ */
+function _progressOptions(vis) {
+    lastProgress.delete(vis);
+    return { timeout: SIMULATION_TIMEOUT, progress: (event) => lastProgress.set(vis, event) };
+}
 
 /**Creates a new QDDVis-object at the server for the requester.
  *
@@ -34,7 +48,7 @@ router.post('/register', (req, res) => {
  * Sends:   take a look at _sendDD documentation
  *
  */
-router.post('/load', (req, res) => {
+router.post('/load', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
         try {
@@ -45,9 +59,11 @@ router.post('/load', (req, res) => {
 
             const algo1 = req.body.algo1 === "true";    //needed to determine the algorithm of verification
 
-            const ret = vis.load(algo, format, opNum, reset, algo1);    //algo1 only used for verification
+            //the async variants do the work on the native worker pool so other sessions aren't blocked meanwhile
+            const ret = await vis.loadAsync(algo, format, opNum, reset, algo1, _progressOptions(vis));    //algo1 only used for verification
+            dm.enforceMemoryBudget();   //a load may acquire a new dd::Package
             if(ret.numOfOperations) {
-                _sendDD(res, vis.getDD(), ret);
+                _sendDD(res, await vis.getDDAsync(), ret);
             } else res.status(500).json({ msg: "Error while loading the algorithm!" });
 
         } catch(err) {
@@ -69,7 +85,7 @@ router.post('/reset', (req, res) => {
 
         } catch(err) {
             const retry = err.message.startsWith("Invalid algorithm!"); //if the algorithm is invalid, we need to send the last valid algorithm
-            res.status(400).json({ msg: err.message, retry: retry});    //I think retry is no longer needed!
+            res.status(_errorStatus(err, 400)).json({ msg: err.message, retry: retry});    //I think retry is no longer needed!
         }
 
     } else {
@@ -85,10 +101,110 @@ router.post('/reset', (req, res) => {
  * Sends:   take a look at _sendDD documentation
  *
  */
-router.get('/getDD', (req, res) => {
+router.get('/getDD', async (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        try {
+            _sendDD(res, await vis.getDDAsync());
+        } catch(err) {
+            res.status(500).json({ msg: err.message });
+        }
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
+/**Sends the DD of the current simulation-state as compact binary node table instead of .dot-text
+ * (layout documented in cpp/module/DDSerializer.h).
+ *
+ * Params:  the key that provides access to the QDDVis-object as query string ("?dataKey=...")
+ *          received from the initial /register-call
+ *
+ * Sends:   the raw bytes as application/octet-stream
+ *
+ */
+router.get('/getDDBinary', async (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        try {
+            const bytes = await vis.getDDBinaryAsync();
+            res.status(200).type('application/octet-stream').send(Buffer.from(bytes.buffer, bytes.byteOffset, bytes.byteLength));
+        } catch(err) {
+            res.status(500).json({ msg: err.message });
+        }
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
+/**Sends the DD of the current simulation-state already laid out, so the client only has to draw it.
+ *
+ * Params:  the key that provides access to the QDDVis-object as query string ("?dataKey=...")
+ *          received from the initial /register-call
+ *          fresh:  [optional] "true" if the positions of the previous layout should not be reused
+ *
+ * Sends:   { layout: {root: {id, re, im}, nodes: [{id, level, x, y}], edges: [{from, to, index, re, im}]} }
+ *
+ */
+router.get('/getLayout', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
-        _sendDD(res, vis.getDD());
+        try {
+            res.status(200).json({ layout: await vis.getLayoutAsync(req.query.fresh === "true") });
+        } catch(err) {
+            res.status(500).json({ msg: err.message });
+        }
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
+/**Sends the DD of the current simulation-state with at most budget expanded nodes, the remaining nodes are collapsed
+ * into summary nodes carrying how many nodes they hide and their probability.
+ *
+ * Params:  the key that provides access to the QDDVis-object as query string ("?dataKey=...")
+ *          received from the initial /register-call
+ *          budget: [optional] maximum number of expanded nodes
+ *          expand: [optional] comma separated ids of summary nodes that should be expanded in addition
+ *
+ * Sends:   { summary: {root: {id, re, im}, nodes: [{id, level, summary, hidden, probability}], edges: [{from, to, index, re, im}]} }
+ *
+ */
+router.get('/getDDSummary', async (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        const options = {};
+        if(req.query.budget) options.budget = parseInt(req.query.budget);
+        if(req.query.expand) options.expand = req.query.expand.split(",").map(id => parseInt(id));
+        try {
+            res.status(200).json({ summary: await vis.getDDSummaryAsync(options) });
+        } catch(err) {
+            res.status(400).json({ msg: err.message });
+        }
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
+/**Sends only the part of the DD of the current simulation-state that lies below the given path from the root.
+ *
+ * Params:  the key that provides access to the QDDVis-object as query string ("?dataKey=...")
+ *          received from the initial /register-call
+ *          path:   values of the top qubits starting with the highest one, e.g. "10" for q[n-1] = 1 and q[n-2] = 0
+ *
+ * Sends:   { dot: normalized sub-DD in .dot-format (empty if the path has probability 0),
+ *            data: { weight: {re, im}, probability } }
+ *
+ */
+router.get('/getSubDD', async (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        try {
+            const sub = await vis.getSubDDAsync(req.query.path || "");
+            _sendDD(res, sub.dot, { weight: sub.weight, probability: sub.probability });
+        } catch(err) {
+            res.status(400).json({ msg: err.message });
+        }
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
     }
@@ -107,7 +223,7 @@ router.get('/getDD', (req, res) => {
  * Sends:   take a look at _sendDD documentation
  *
  */
-router.put('/updateExportOptions', (req, res) => {
+router.put('/updateExportOptions', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
         const showColored = req.body.colored === "true";
@@ -115,10 +231,14 @@ router.put('/updateExportOptions', (req, res) => {
         const showClassic = req.body.classic === "true";
         const updateDD = req.body.updateDD === "true";
 
-        vis.updateExportOptions(showColored, showEdgeLabels, showClassic);
+        try {
+            vis.updateExportOptions(showColored, showEdgeLabels, showClassic);
 
-        if(vis.isReady() && updateDD) _sendDD(res, vis.getDD());
-        else res.status(200).end(); //end the call without sending data
+            if(vis.isReady() && updateDD) _sendDD(res, await vis.getDDAsync());
+            else res.status(200).end(); //end the call without sending data
+        } catch(err) {
+            res.status(_errorStatus(err, 400)).json({ msg: err.message });
+        }
 
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
@@ -143,17 +263,24 @@ router.get('/getExportOptions', (req, res) => {
  *
  *          algo1:   [Verification only] "true" means that the functionality is used for algo1, "false" for algo2
  *
- *  Sends:   take a look at _sendDD documentation
+ *  Sends:   take a look at _sendState documentation
+ *          [Verification only] data is {verdict, nonIdentityNodes} - whether the DD is the identity
+ *          ("equivalent", "equivalentUpToGlobalPhase", "notEquivalent" or "notYet") and how many of its nodes differ from it
  *          may also send back a simple message if the simulation was already at the start and therefore nothing changed
  *
  */
-router.get('/tostart', (req, res) => {
+router.get('/tostart', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
         const algo1 = req.query.algo1 === "true";    //needed to determine the algorithm of verification
-        const ret = vis.toStart(algo1);             //algo1 only used for verification
-        if(ret) _sendDD(res, vis.getDD());
-        else res.status(403).json({ msg: "you were already at the start" });    //the client will search for res.svg, but it will be null so they won't redraw
+        try {
+            const ret = await vis.toStartAsync(algo1);  //algo1 only used for verification
+            if(ret === true) await _sendState(req, res, vis);
+            else if(ret.changed) await _sendState(req, res, vis, {verdict: ret.verdict, nonIdentityNodes: ret.nonIdentityNodes});   //verification also sends whether it already is the identity
+            else res.status(403).json({ msg: "you were already at the start" });    //the client will search for res.svg, but it will be null so they won't redraw
+        } catch(err) {
+            res.status(_errorStatus(err, 500)).json({ msg: err.message });
+        }
 
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
@@ -167,18 +294,22 @@ router.get('/tostart', (req, res) => {
  *
  *          algo1:   [Verification only] "true" means that the functionality is used for algo1, "false" for algo2
  *
- * Sends:   take a look at _sendDD documentation
+ * Sends:   take a look at _sendState documentation
  *          may also send back a simple message if the simulation was already at the start and therefore no operation
  *          was undone and nothing changed
  *
  */
-router.get('/prev', (req, res) => {
+router.get('/prev', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
         const algo1 = req.query.algo1 === "true";    //needed to determine the algorithm of verification
-        const ret = vis.prev(algo1);                 //algo1 only used for verification
-        if(ret.changed) _sendDD(res, vis.getDD(), {noGoingBack: ret.noGoingBack}); //something changes so we update the shown dd
-        else res.status(403).json({ msg: "can't go back because we are at the beginning" });    //the client will search for res.svg, but it will be null so they won't redraw
+        try {
+            const ret = await vis.prevAsync(algo1);     //algo1 only used for verification
+            if(ret.changed) await _sendState(req, res, vis, {noGoingBack: ret.noGoingBack, verdict: ret.verdict, nonIdentityNodes: ret.nonIdentityNodes}); //something changes so we update the shown dd
+            else res.status(403).json({ msg: "can't go back because we are at the beginning" });    //the client will search for res.svg, but it will be null so they won't redraw
+        } catch(err) {
+            res.status(_errorStatus(err, 500)).json({ msg: err.message });
+        }
 
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
@@ -192,34 +323,42 @@ router.get('/prev', (req, res) => {
  *
  *          algo1:   [Verification only] "true" means that the functionality is used for algo1, "false" for algo2
  *
- * Sends:   take a look at _sendDD documentation
+ * Sends:   take a look at _sendState documentation
  *          may also send back a simple message if the simulation was already at the end and therefore no operation
  *          was applied and nothing changed
  *
  */
-router.get('/next', (req, res) => {
+router.get('/next', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
         const algo1 = req.query.algo1 === "true";    //needed to determine the algorithm of verification
-        const ret = vis.next(algo1);                //algo1 only used for verification
+        try {
+            const ret = await vis.nextAsync(algo1);     //algo1 only used for verification
 
-        if(ret.changed) _sendDD(res, vis.getDD(), ret); //something changes so we update the shown dd
-        else res.send({ msg: "can't go ahead because we are at the end", reload: "false" });
+            if(ret.changed) await _sendState(req, res, vis, ret); //something changes so we update the shown dd
+            else res.send({ msg: "can't go ahead because we are at the end", reload: "false" });
+        } catch(err) {
+            res.status(_errorStatus(err, 500)).json({ msg: err.message });
+        }
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
     }
 });
 
-router.get('/conductIrreversibleOperation', (req, res) => {
+router.get('/conductIrreversibleOperation', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
-        let data = JSON.parse(req.query.parameter);
-        const ret = vis.conductIrreversibleOperation(data);
+        try {
+            let data = JSON.parse(req.query.parameter);
+            const ret = vis.conductIrreversibleOperation(data);
 
-        if (!ret.finished) {
-            res.status(200).json({dot: vis.getDD(), finished: ret.finished, parameter: ret.parameter});
-        } else {
-            res.status(200).json({dot: vis.getDD(), finished: ret.finished});
+            if (!ret.finished) {
+                res.status(200).json({dot: await vis.getDDAsync(), finished: ret.finished, parameter: ret.parameter});
+            } else {
+                res.status(200).json({dot: await vis.getDDAsync(), finished: ret.finished});
+            }
+        } catch(err) {
+            res.status(_errorStatus(err, 400)).json({ msg: err.message });
         }
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
@@ -233,23 +372,85 @@ router.get('/conductIrreversibleOperation', (req, res) => {
  *
  *          algo1:   [Verification only] "true" means that the functionality is used for algo1, "false" for algo2
  *
- * Sends:   take a look at _sendDD documentation
+ * Sends:   take a look at _sendState documentation
  *          may also send back a simple message if the simulation was already at the end and therefore nothing changed
  *
  */
-router.get('/toend', (req, res) => {
+router.get('/toend', async (req, res) => {
     const vis = dm.get(req);
     if(vis) {
         const algo1 = req.query.algo1 === "true";    //needed to determine the algorithm of verification
-        const ret = vis.toEnd(algo1);               //algo1 only used for verification
-        if(ret.changed) _sendDD(res, vis.getDD(), {nops: ret.nops, nextIsIrreversible: ret.nextIsIrreversible, barrier: ret.barrier});  //sendFile(res, data.ip); //something changes so we update the shown dd
-        else res.send({ msg: "you were already at the end", reload: "false" });
+        try {
+            const ret = await vis.toEndAsync(algo1, _progressOptions(vis));    //algo1 only used for verification
+            if(ret.changed) await _sendState(req, res, vis, {nops: ret.nops, nextIsIrreversible: ret.nextIsIrreversible, barrier: ret.barrier, cancelled: ret.cancelled, verdict: ret.verdict, nonIdentityNodes: ret.nonIdentityNodes});  //sendFile(res, data.ip); //something changes so we update the shown dd
+            else res.send({ msg: "you were already at the end", reload: "false" });
+        } catch(err) {
+            res.status(500).json({ msg: err.message });
+        }
 
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
     }
 });
 
+/**[Verification only] Applies the remaining operations of both algorithms and checks whether they are equivalent.
+ *
+ * Params:  the key that provides access to the QDDVer-object as query string ("?dataKey=...")
+ *          received from the initial /register-call
+ *
+ *          strategy: "naive", "oneToOne", "proportional" (default) or "lookahead" - which algorithm the next operation
+ *                    is taken from
+ *          stimuli:  number of random inputs both algorithms are simulated on first (default 0), the matrices are only
+ *                    compared if all outputs agree
+ *          stimuliType: "basis" (default) or "product" - which kind of random inputs is used
+ *          seed:     seed of the random inputs (optional)
+ *
+ * Sends:   take a look at _sendState documentation, data is {
+ *      equivalence - {strategy, verdict, peakNodes, ops, time (in µs), cancelled,
+ *                     stimuli: {simulated, differ, stimulus, input, fidelity, time, cancelled} (only with stimuli)}
+ * }
+ */
+router.get('/checkEquivalence', async (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        try {
+            const options = _progressOptions(vis);
+            if(req.query.stimuli) options.stimuli = parseInt(req.query.stimuli) || 0;
+            if(req.query.stimuliType) options.stimuliType = req.query.stimuliType;
+            if(req.query.seed) options.seed = parseInt(req.query.seed) || 0;
+            const result = await vis.checkEquivalenceAsync(req.query.strategy, options);
+            await _sendState(req, res, vis, { equivalence: result });
+        } catch(err) {
+            res.status(400).json({ msg: err.message });
+        }
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
+/**[Verification only] Searches an input and output for which the current DD differs from the identity and the
+ * operation that made the verification diverge from it. The shown DD doesn't change.
+ *
+ * Params:  the key that provides access to the QDDVer-object as query string ("?dataKey=...")
+ *          received from the initial /register-call
+ *
+ * Sends:   {counterexample: {found, input, output, amplitude, expected, deviation, divergence}} - divergence is
+ *          {position1, position2, algo1, operation} or null if the operation couldn't be found
+ */
+router.get('/findCounterexample', async (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        try {
+            const result = await vis.findCounterexampleAsync();
+            res.status(200).json({ counterexample: result });
+        } catch(err) {
+            res.status(400).json({ msg: err.message });
+        }
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
 /**Transfers the simulation to a specific position in the algorithm either by applying or undoing operations until said
  * position has been reached.
  *
@@ -258,20 +459,82 @@ router.get('/toend', (req, res) => {
  *
  *          algo1:   [Verification only] "true" means that the functionality is used for algo1, "false" for algo2
  *
- * Sends:   take a look at _sendDD documentation
+ * Sends:   take a look at _sendState documentation
  *          may also send back a simple message if the simulation was already at the given line and therefore no operation
  *          was applied or undone, so nothing changed
  *
  */
-router.get('/toline', (req, res) => {
+router.get('/toline', async (req, res) => {
     const vis = dm.get(req);
     const line = parseInt(req.query.line);
     const algo1 = req.query.algo1 === "true";    //needed to determine the algorithm of verification
     if(vis) {
-        const ret = vis.toLine(line, algo1);    //algo1 only used for verification
-        if(ret.changed) _sendDD(res, vis.getDD(), {nops: ret.nops, nextIsIrreversible: ret.nextIsIrreversible, noGoingBack: ret.noGoingBack, reset: ret.reset});  //something changes so we update the shown dd
-        else res.send({ msg: "you were already at line " + line, reload: "false" , data: {nextIsIrreversible: ret.nextIsIrreversible, noGoingBack: ret.noGoingBack}});
+        try {
+            const ret = await vis.toLineAsync(line, algo1, _progressOptions(vis));    //algo1 only used for verification
+            if(ret.changed) await _sendState(req, res, vis, {nops: ret.nops, nextIsIrreversible: ret.nextIsIrreversible, noGoingBack: ret.noGoingBack, reset: ret.reset, cancelled: ret.cancelled, verdict: ret.verdict, nonIdentityNodes: ret.nonIdentityNodes});  //something changes so we update the shown dd
+            else res.send({ msg: "you were already at line " + line, reload: "false" , data: {nextIsIrreversible: ret.nextIsIrreversible, noGoingBack: ret.noGoingBack}});
+        } catch(err) {
+            res.status(500).json({ msg: err.message });
+        }
+
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
+/**Conducts the measurement or reset the simulation currently points at for all of its qubits in one call.
+ *
+ * Params:  the key that provides access to the QDDVis-object as query string ("?dataKey=...")
+ *          outcomes:   [optional] string with the outcome ('0' or '1') of every qubit of the operation in their order
+ *          seed:       [optional] if no outcomes are given, they are drawn randomly with this seed
+ *
+ * Sends:   take a look at _sendDD documentation, data contains the outcome and probabilities of every qubit
+ */
+router.get('/measureRegister', async (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        const options = {};
+        if(req.query.outcomes) options.outcomes = req.query.outcomes;
+        else if(req.query.seed) options.seed = parseInt(req.query.seed);
+        try {
+            const ret = await vis.measureRegisterAsync(options);
+            _sendDD(res, await vis.getDDAsync(), ret);
+        } catch(err) {
+            res.status(400).json({ msg: err.message });
+        }
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
 
+/**Stops the currently running simulation (/load, /toend or /toline) after the operation it is currently applying.
+ * The running request then responds as usual with the state at the last applied operation and cancelled set to true.
+ *
+ * Params:  the key that provides access to the QDDVis-object as query string ("?dataKey=...")
+ * Sends:   nothing
+ */
+router.post('/cancel', (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        vis.cancel();
+        res.status(200).json({});
+    } else {
+        res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
+    }
+});
+
+/**Returns the latest progress of the currently running simulation.
+ *
+ * Params:  the key that provides access to the QDDVis-object as query string ("?dataKey=...")
+ * Sends:   {
+ *      progress - {ops, position, nodes, elapsed} or null if no progress has been reported yet
+ * }
+ */
+router.get('/progress', (req, res) => {
+    const vis = dm.get(req);
+    if(vis) {
+        const progress = lastProgress.get(vis);
+        res.status(200).json({ progress: progress ? progress : null });
     } else {
         res.status(404).json({ msg: "Your data is no longer available. Your page will be reloaded!" });
     }
@@ -281,6 +544,16 @@ const exAlgoDir = "./cpp/sample_qasm"
 const exAlgoNames = [];
 const exampleAlgos = [];
 
+/**Parses an example algorithm once at startup, so loading it is only a lookup in the native cache.
+ *
+ * @param name name of the example
+ * @param algo the algorithm
+ * @param format format code of the algorithm
+ */
+function _preloadExample(name, algo, format) {
+    if(!qddVis.preloadCircuit(algo, format)) console.log("Couldn't parse the example algorithm " + name);
+}
+
 function _readFiles(dirPath) {
     //load all example algorithms
     fs.readdirSync(dirPath).forEach(file => {
@@ -298,6 +571,7 @@ function _readFiles(dirPath) {
                     name: name,
                     format: 1        //QASM_FORMAT       //todo it would be safer if we just send "qasm" and let the client determine the format-code
                 });
+                _preloadExample(name, algo, 1);
             } else if(ending === "real") {
                 exAlgoNames.push(name);
 
@@ -307,6 +581,7 @@ function _readFiles(dirPath) {
                     name: name,
                     format: 2       //REAL_FORMAT       //todo it would be safer if we just send "qasm" and let the client determine the format-code
                 });
+                _preloadExample(name, algo, 2);
             }
         } else {    //potential directory found
             const path = dirPath + "/" + file;
@@ -335,6 +610,18 @@ router.get('/exampleAlgo', (req, res) => {
 
 module.exports = router;
 
+/**The synchronous methods of the C++ objects throw "Busy!" while one of their asynchronous calls is still queued or
+ * running, the requester may simply try again later in that case.
+ *
+ * @param err the error thrown by the C++ object
+ * @param status the status to respond with for any other error
+ * @returns 409 (Conflict) if the object was busy, status otherwise
+ * @private
+ */
+function _errorStatus(err, status) {
+    return err.message.startsWith("Busy!") ? 409 : status;
+}
+
 /**Convenience function for sending the DD to the requester.
  *
  * @param res response-object needed to send something to the requester
@@ -346,3 +633,25 @@ function _sendDD(res, dd, data) {
     if(data || data === 0) res.status(200).json({ dot: dd, data: data });
     else res.status(200).json({ dot: dd });
 }
+
+/**Convenience function for sending the DD of a stepping-request. If the request has the query parameter "diff=true",
+ * only the changes since the last diff are sent ({ diff: ..., data: ... }, take a look at getDDDiff in the C++ module;
+ * diff is null if the DD didn't change structurally). "full=true" makes the diff start from the empty graph.
+ * Otherwise the whole DD is sent as described in _sendDD. The DD is exported on the worker pool, so the request waits
+ * for earlier calls of the same object instead of failing because it is busy.
+ *
+ * @param req request-object containing the query parameters
+ * @param res response-object needed to send something to the requester
+ * @param vis the object whose DD is sent
+ * @param data some optional data some of the callers of this function need to send along with the DD
+ * @private
+ */
+async function _sendState(req, res, vis, data) {
+    if(req.query.diff === "true") _sendDiff(res, await vis.getDDDiffAsync(req.query.full === "true"), data);
+    else _sendDD(res, await vis.getDDAsync(), data);
+}
+
+function _sendDiff(res, diff, data) {
+    if(data || data === 0) res.status(200).json({ diff: diff, data: data });
+    else res.status(200).json({ diff: diff });
+}